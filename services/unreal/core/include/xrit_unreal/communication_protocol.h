@@ -2,6 +2,9 @@
 #define XRIT_UNREAL_COMMUNICATION_PROTOCOL_H
 
 #include "data/communication_protocol.h"
+#include "reflect/serialize.h"
+
+#include <string>
 
 namespace xrit_unreal
 {
@@ -9,19 +12,19 @@ namespace xrit_unreal
 struct UnrealMessageData
 {
     UnrealCommand command;
-    std::string_view data;
+    simdjson::padded_string_view data;
 };
 
 // a message from the Unreal service to the Xrit Node
 struct NodeMessageData
 {
     NodeCommand command;
-    std::string_view data;
+    simdjson::padded_string_view data;
 };
 
 // returns true if message is well-formed, otherwise returns false
-// sets outMessage on success
-[[nodiscard]] bool getMessageData(std::string_view message, MessageData *outMessage);
+// sets outMessage on success, its data is a view of the end of message, so it has the same padding
+[[nodiscard]] bool getMessageData(simdjson::padded_string_view message, MessageData *outMessage);
 
 // returns true if valid unreal message, otherwise returns false
 // if valid message, sets outMessage's values
@@ -34,8 +37,51 @@ struct NodeMessageData
 // creates a string that can be sent over the network to the node
 [[nodiscard]] std::string createNodeMessage(NodeCommand nodeCommand, std::string_view data);
 
+// builds a message for the node inside a single buffer, so that the payload can be serialized directly after the
+// header ("channel:command\n"), without creating intermediate strings.
+//
+// usage:
+// NodeMessageBuilder builder(NodeCommand::status);
+// serialize(status, builder.payload());
+// webSocket.sendMessage(std::move(builder).finish());
+class NodeMessageBuilder
+{
+  public:
+    // payloadCapacity is the amount of bytes to reserve for the payload
+    explicit NodeMessageBuilder(NodeCommand nodeCommand, size_t payloadCapacity = 0);
+
+    // writer that appends directly after the header
+    [[nodiscard]] JsonWriter &payload();
+
+    // moves the message out of the builder, the builder should not be used afterwards
+    [[nodiscard]] std::string finish() &&;
+
+  private:
+    std::string message;
+    JsonWriter out{message};
+    size_t headerSize;
+};
+
 // the plugin should never need to create such a message, but for mocking it can be useful
 [[nodiscard]] std::string createMockUnrealMessage(UnrealCommand unrealCommand, std::string_view data);
+
+// the capabilities that are supported by this version of the core
+[[nodiscard]] Capabilities supportedCapabilities();
+
+// returns the features that are supported by both the local and the remote side
+// the heartbeat interval is the largest of both intervals, or 0 if either side does not support heartbeats
+[[nodiscard]] Capabilities negotiateCapabilities(Capabilities const &local, Capabilities const &remote);
+
+// returns true if data contains valid capabilities, otherwise returns false
+// empty data (sent by peers that don't support capabilities yet) results in all features being disabled.
+// fields that are unknown to this version are ignored, so that newer peers can add capabilities
+[[nodiscard]] bool parseCapabilities(std::string_view data, Capabilities &outCapabilities);
+
+// same as above, without copying data
+[[nodiscard]] bool parseCapabilities(simdjson::padded_string_view data, Capabilities &outCapabilities);
+
+// creates the payload for the `initialized` and `capabilities` messages
+[[nodiscard]] std::string serializeCapabilities(Capabilities capabilities);
 } // namespace xrit_unreal
 
 #endif // XRIT_UNREAL_COMMUNICATION_PROTOCOL_H
\ No newline at end of file
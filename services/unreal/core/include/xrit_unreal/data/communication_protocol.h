@@ -3,6 +3,8 @@
 
 #include "../reflect/reflect.h"
 
+#include <simdjson.h>
+
 #include <string_view>
 
 namespace xrit_unreal
@@ -17,7 +19,7 @@ struct MessageData
 {
     std::string_view channel;
     std::string_view command;
-    std::string_view data;
+    simdjson::padded_string_view data; // keeps the padding of the message, so it can be parsed without copying
 };
 
 REFLECT_ENUM
@@ -41,6 +43,7 @@ enum class UnrealCommand
     Invalid,
     set_configuration,
     get_status,
+    capabilities, // reply to `initialized`, contains the capabilities of the node
     Count
 };
 
@@ -51,11 +54,28 @@ REFLECT_ENUM
 enum class NodeCommand
 {
     Invalid,
-    initialized,
+    initialized, // contains the capabilities of the unreal service
     set_configuration_result,
     status,
     Count
 };
+
+// optional features that can be used for communication between the unreal service and the XR-IT Node.
+//
+// when the connection starts, the unreal service sends its capabilities in the `initialized` message, and the node
+// replies with its own capabilities in the `capabilities` message. Both sides then use only the features that both
+// support (see negotiateCapabilities).
+// a peer that does not send any capabilities supports none of the features, which results in the plain text protocol.
+REFLECT_STRUCT
+
+struct Capabilities
+{
+    bool REFLECT(compression) = false;           // payloads can be compressed
+    bool REFLECT(binary_envelope) = false;       // messages can use a binary envelope instead of "channel:command\n"
+    bool REFLECT(delta_status) = false;          // a status can contain only the changes since the previous status
+    bool REFLECT(batching) = false;              // multiple messages can be sent in one websocket message
+    uint64_t REFLECT(heartbeat_interval_ms) = 0; // 0 means no heartbeat
+};
 } // namespace xrit_unreal
 
 #include "communication_protocol_generated.h"
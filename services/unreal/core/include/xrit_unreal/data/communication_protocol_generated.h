@@ -3,6 +3,14 @@
 // don't edit this file directly.
 // -----------------------------------------------------------
 
+REFLECT_IMPL_STRUCT_BEGIN(xrit_unreal::Capabilities)
+    REFLECT_IMPL_FIELD(compression)
+    REFLECT_IMPL_FIELD(binary_envelope)
+    REFLECT_IMPL_FIELD(delta_status)
+    REFLECT_IMPL_FIELD(batching)
+    REFLECT_IMPL_FIELD(heartbeat_interval_ms)
+REFLECT_IMPL_STRUCT_END
+
 REFLECT_IMPL_ENUM_BEGIN(xrit_unreal::Channel)
     REFLECT_IMPL_CASE(unreal_to_node)
     REFLECT_IMPL_CASE(node_to_unreal)
@@ -11,6 +19,7 @@ REFLECT_IMPL_ENUM_END
 REFLECT_IMPL_ENUM_BEGIN(xrit_unreal::UnrealCommand)
     REFLECT_IMPL_CASE(set_configuration)
     REFLECT_IMPL_CASE(get_status)
+    REFLECT_IMPL_CASE(capabilities)
 REFLECT_IMPL_ENUM_END
 
 REFLECT_IMPL_ENUM_BEGIN(xrit_unreal::NodeCommand)
@@ -74,7 +74,7 @@ struct LiveLinkDummySourceSettings
 {
     std::string_view REFLECT(ip_address);
     int64_t REFLECT(port);
-    LiveLinkSourceSettings REFLECT(base);
+    LiveLinkSourceSettings REFLECT_MUTABLE(base); // can be updated without recreating the source
 };
 
 REFLECT_STRUCT
@@ -82,7 +82,7 @@ REFLECT_STRUCT
 struct LiveLinkMvnSourceSettings
 {
     int64_t REFLECT(port);
-    LiveLinkSourceSettings REFLECT(base);
+    LiveLinkSourceSettings REFLECT_MUTABLE(base); // can be updated without recreating the source
 };
 
 REFLECT_STRUCT
@@ -92,7 +92,7 @@ struct LiveLinkOptitrackSourceSettings
     std::string_view REFLECT(server_address);
     std::string_view REFLECT(client_address);
     bool REFLECT(is_multicast);
-    LiveLinkSourceSettings REFLECT(base);
+    LiveLinkSourceSettings REFLECT_MUTABLE(base); // can be updated without recreating the source
 };
 
 REFLECT_STRUCT
@@ -103,7 +103,7 @@ struct LiveLinkXrSourceSettings
     bool REFLECT(track_controllers) = false;
     bool REFLECT(track_hmds) = false;
     uint64_t REFLECT(local_update_rate_in_hz) = 60;
-    LiveLinkSourceSettings REFLECT(base);
+    LiveLinkSourceSettings REFLECT_MUTABLE(base); // can be updated without recreating the source
 };
 
 REFLECT_STRUCT
@@ -147,7 +147,7 @@ struct LiveLinkFreeDSourceSettings
 {
     std::string_view REFLECT(ip_address) = "127.0.0.1"; // IP address of the free-d tracking source
     uint64_t REFLECT(udp_port) = 40000;                 // UDP port number
-    LiveLinkSourceSettings REFLECT(base);
+    LiveLinkSourceSettings REFLECT_MUTABLE(base); // can be updated without recreating the source
     bool REFLECT(send_extra_metadata) = false; // Send extra string metadata (Camera ID and FrameCounter)
     FreeDDefaultConfigs REFLECT(default_config) =
         FreeDDefaultConfigs::None; // Default configurations for specific manufacturers
@@ -166,7 +166,7 @@ struct LiveLinkMessageBusSourceSettings
     std::string_view REFLECT(source_type);
     std::string_view REFLECT(machine_name);
     Guid REFLECT(address);
-    LiveLinkSourceSettings REFLECT(base);
+    LiveLinkSourceSettings REFLECT_MUTABLE(base); // can be updated without recreating the source
 };
 
 REFLECT_STRUCT
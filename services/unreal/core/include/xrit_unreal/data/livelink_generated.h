@@ -31,19 +31,19 @@ REFLECT_IMPL_STRUCT_END
 REFLECT_IMPL_STRUCT_BEGIN(xrit_unreal::LiveLinkDummySourceSettings)
 REFLECT_IMPL_FIELD (ip_address)
 REFLECT_IMPL_FIELD (port)
-REFLECT_IMPL_FIELD (base)
+REFLECT_IMPL_MUTABLE_FIELD (base)
 REFLECT_IMPL_STRUCT_END
 
 REFLECT_IMPL_STRUCT_BEGIN(xrit_unreal::LiveLinkMvnSourceSettings)
 REFLECT_IMPL_FIELD (port)
-REFLECT_IMPL_FIELD (base)
+REFLECT_IMPL_MUTABLE_FIELD (base)
 REFLECT_IMPL_STRUCT_END
 
 REFLECT_IMPL_STRUCT_BEGIN(xrit_unreal::LiveLinkOptitrackSourceSettings)
 REFLECT_IMPL_FIELD (server_address)
 REFLECT_IMPL_FIELD (client_address)
 REFLECT_IMPL_FIELD (is_multicast)
-REFLECT_IMPL_FIELD (base)
+REFLECT_IMPL_MUTABLE_FIELD (base)
 REFLECT_IMPL_STRUCT_END
 
 REFLECT_IMPL_STRUCT_BEGIN(xrit_unreal::LiveLinkXrSourceSettings)
@@ -51,7 +51,7 @@ REFLECT_IMPL_FIELD (track_trackers)
 REFLECT_IMPL_FIELD (track_controllers)
 REFLECT_IMPL_FIELD (track_hmds)
 REFLECT_IMPL_FIELD (local_update_rate_in_hz)
-REFLECT_IMPL_FIELD (base)
+REFLECT_IMPL_MUTABLE_FIELD (base)
 REFLECT_IMPL_STRUCT_END
 
 REFLECT_IMPL_STRUCT_BEGIN(xrit_unreal::VirtualSubjectSourceSettings)
@@ -69,7 +69,7 @@ REFLECT_IMPL_STRUCT_END
 REFLECT_IMPL_STRUCT_BEGIN(xrit_unreal::LiveLinkFreeDSourceSettings)
 REFLECT_IMPL_FIELD (ip_address)
 REFLECT_IMPL_FIELD (udp_port)
-REFLECT_IMPL_FIELD (base)
+REFLECT_IMPL_MUTABLE_FIELD (base)
 REFLECT_IMPL_FIELD (send_extra_metadata)
 REFLECT_IMPL_FIELD (default_config)
 REFLECT_IMPL_FIELD (focus_distance_encoder_data)
@@ -81,7 +81,7 @@ REFLECT_IMPL_STRUCT_BEGIN(xrit_unreal::LiveLinkMessageBusSourceSettings)
 REFLECT_IMPL_FIELD (source_type)
 REFLECT_IMPL_FIELD (machine_name)
 REFLECT_IMPL_FIELD (address)
-REFLECT_IMPL_FIELD (base)
+REFLECT_IMPL_MUTABLE_FIELD (base)
 REFLECT_IMPL_STRUCT_END
 
 REFLECT_IMPL_STRUCT_BEGIN(xrit_unreal::LiveLinkDummySource)
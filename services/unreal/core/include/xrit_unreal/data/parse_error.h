@@ -24,7 +24,7 @@ REFLECT_STRUCT
 struct ParseError
 {
     ParseErrorCode REFLECT(code);                // for actual error handling
-    std::string_view REFLECT(containing_object); // for identifying the object to which the error applies
+    std::string_view REFLECT(containing_object); // json pointer to the object to which the error applies
     std::string_view REFLECT(value);             // for identifying the value to which the error applies
     std::string_view REFLECT(message);           // user facing message
 };
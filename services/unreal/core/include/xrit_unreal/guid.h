@@ -20,11 +20,22 @@ namespace xrit_unreal
 // string SHOULD be 8 characters long
 [[nodiscard]] uint32_t parseHexNumber32Bits(std::string_view string);
 
+// amount of characters of a guid string, 32 hex characters and 4 hyphens
+constexpr size_t guidStringLength = 36;
+
 // we only support guids that are encoded like this (16 bytes in hex):
 // "ab47a721-e1ae-4c71-abab-a3c7075a98ee"
 // letters can be uppercase or lowercase
+// returns an error message, or an empty string view on success (does not allocate)
+[[nodiscard]] std::string_view tryParseGuid(std::string_view string, Guid &outGuid);
+
+// same as tryParseGuid, but returns the error as ParseError
 [[nodiscard]] std::vector<ParseError> parseGuid(std::string_view string, Guid &outGuid, std::string_view fieldName);
 
+// writes the guid as exactly guidStringLength lowercase characters to out (not null terminated, does not allocate)
+void formatGuid(Guid const &guid, char *out);
+
+// same as formatGuid, but into a new string
 [[nodiscard]] std::string serializeGuid(Guid const &guid);
 } // namespace xrit_unreal
 
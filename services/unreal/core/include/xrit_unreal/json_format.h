@@ -0,0 +1,26 @@
+#ifndef XRIT_UNREAL_JSON_FORMAT_H
+#define XRIT_UNREAL_JSON_FORMAT_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace xrit_unreal
+{
+// formatting of json text, e.g. for printing received messages or writing mock data
+//
+// the json is not validated: whitespace outside of strings is replaced, and everything else (strings, numbers,
+// literals) is copied as is. Strings (including escaped quotes) are never modified
+
+// adds newlines and indentation, with ": " between keys and values. Empty objects and arrays stay on one line
+// indentationCount is the amount of spaces or tabs
+// indentationCharacter is the character to use for indentation (e.g. spaces or tabs)
+constexpr uint32_t defaultIndentationAmount = 4;
+[[nodiscard]] std::string prettifyJson(std::string_view json, uint32_t indentationCount = defaultIndentationAmount,
+                                       char indentationCharacter = ' ');
+
+// removes all whitespace outside of strings
+[[nodiscard]] std::string minifyJson(std::string_view json);
+} // namespace xrit_unreal
+
+#endif // XRIT_UNREAL_JSON_FORMAT_H
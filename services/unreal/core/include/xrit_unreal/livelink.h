@@ -4,17 +4,21 @@
 #include "data/configuration.h"
 #include "data/livelink.h"
 #include "guid.h"
+#include "string_arena.h"
 
 #include <functional>
+#include <memory>
 
 namespace xrit_unreal
 {
 struct LiveLinkSourceCacheEntry
 {
     Guid unrealGuid; // the Guid of the source internally used by Unreal Engine
-    size_t settingsHash;
-    // hash for settings that *can't* be updated after a source has been created (so "base" is excluded)
+    uint64_t settingsHash;
+    // hash for settings that *can't* be updated after a source has been created (so "base" is excluded, see
+    // REFLECT_MUTABLE)
     LiveLinkSourceVariants value;
+    std::shared_ptr<StringArena const> strings; // owns the strings value references, if it was parsed with an arena
 };
 
 struct LiveLinkSourceCache
@@ -32,11 +36,21 @@ struct LiveLinkCallbacks
     // update source with the given unrealId
 };
 
-// if `setLiveLinkSources` symbol is not defined: check whether all `std::hash` template specializations are there for
-// all source types.
-[[nodiscard]] std::vector<LiveLinkError> setLiveLinkSources(LiveLinkSourceCache &cache,
-                                                            std::vector<LiveLinkSourceVariants> const &desiredSources,
-                                                            LiveLinkCallbacks const &callbacks) noexcept;
+// what setLiveLinkSources did for the desired sources
+struct LiveLinkSourceChanges
+{
+    size_t created = 0;   // including sources that were recreated because their settings hash changed
+    size_t updated = 0;
+    size_t unchanged = 0; // equal to the cached source, so updateSource was not called
+    size_t removed = 0;   // sources for which removeSource did not return errors
+};
+
+// strings is stored in the cache entries of created and updated sources, to keep the strings of the sources alive
+// sources that are equal to their cache entry are not updated, outChanges (if set) counts them and the other changes
+[[nodiscard]] std::vector<LiveLinkError> setLiveLinkSources(
+    LiveLinkSourceCache &cache, std::vector<LiveLinkSourceVariants> const &desiredSources,
+    LiveLinkCallbacks const &callbacks, std::shared_ptr<StringArena const> const &strings = nullptr,
+    LiveLinkSourceChanges *outChanges = nullptr) noexcept;
 } // namespace xrit_unreal
 
 #endif // XRIT_UNREAL_LIVELINK_H
\ No newline at end of file
@@ -3,6 +3,10 @@
 
 #include <simdjson.h>
 
+#include <memory>
+#include <mutex>
+#include <vector>
+
 namespace xrit_unreal
 {
 // holds data for iteration and parsing
@@ -15,6 +19,114 @@ struct JsonDocument
 
 // convenience method for setting the parser, document and padded json as seen in JsonDocument
 [[nodiscard]] simdjson::error_code parseJson(std::string_view json, JsonDocument &out);
+
+// parser with a padded copy of the json it parses, both keep their capacity between documents
+struct PooledJsonParser
+{
+    simdjson::ondemand::parser parser;
+    std::unique_ptr<char[]> buffer;
+    size_t bufferCapacity = 0;
+};
+
+class JsonParserPool;
+
+// document parsed by a parser of a JsonParserPool, gives the parser back to the pool when destroyed
+// values parsed from the document (e.g. string views) are only valid as long as the document exists
+class PooledJsonDocument
+{
+public:
+    PooledJsonDocument() = default;
+
+    ~PooledJsonDocument();
+
+    PooledJsonDocument(PooledJsonDocument const &) = delete;
+    PooledJsonDocument &operator=(PooledJsonDocument const &) = delete;
+    PooledJsonDocument(PooledJsonDocument &&) noexcept = default;
+    PooledJsonDocument &operator=(PooledJsonDocument &&) noexcept;
+
+    simdjson::ondemand::document document;
+
+private:
+    friend class JsonParserPool;
+
+    // gives the parser back to the pool
+    void release();
+
+    JsonParserPool *pool = nullptr;
+    std::unique_ptr<PooledJsonParser> parser;
+};
+
+// stream of documents parsed by a parser of a JsonParserPool, gives the parser back to the pool when destroyed
+class PooledJsonDocumentStream
+{
+public:
+    PooledJsonDocumentStream() = default;
+
+    ~PooledJsonDocumentStream();
+
+    PooledJsonDocumentStream(PooledJsonDocumentStream const &) = delete;
+    PooledJsonDocumentStream &operator=(PooledJsonDocumentStream const &) = delete;
+    PooledJsonDocumentStream(PooledJsonDocumentStream &&) noexcept = default;
+    PooledJsonDocumentStream &operator=(PooledJsonDocumentStream &&) noexcept;
+
+    simdjson::ondemand::document_stream stream;
+
+private:
+    friend class JsonParserPool;
+
+    // gives the parser back to the pool
+    void release();
+
+    JsonParserPool *pool = nullptr;
+    std::unique_ptr<PooledJsonParser> parser;
+};
+
+// thread safe pool of parsers, so that parsing a message doesn't allocate the buffers of the parser again (which are
+// sized to the largest document it has parsed)
+// parsers that have grown beyond maxCapacity (e.g. for one very large message) are freed instead of kept in the pool
+class JsonParserPool
+{
+public:
+    static constexpr size_t defaultMaxCapacity = 4 * 1024 * 1024;
+
+    explicit JsonParserPool(size_t maxCapacity = defaultMaxCapacity);
+
+    // copies the json into the padded buffer of a parser from the pool and starts iterating it
+    [[nodiscard]] simdjson::error_code parse(std::string_view json, PooledJsonDocument &out);
+
+    // starts iterating the already padded json with a parser from the pool, without copying it
+    // json should outlive out
+    [[nodiscard]] simdjson::error_code parse(simdjson::padded_string_view json, PooledJsonDocument &out);
+
+    // starts iterating the already padded json, which contains multiple documents, with a parser from the pool,
+    // without copying it. the parser processes batchSize bytes of the json at a time
+    // json should outlive out
+    [[nodiscard]] simdjson::error_code parseMany(simdjson::padded_string_view json, size_t batchSize,
+                                                 PooledJsonDocumentStream &out);
+
+    // number of parsers waiting to be reused
+    [[nodiscard]] size_t size() const;
+
+private:
+    friend class PooledJsonDocument;
+    friend class PooledJsonDocumentStream;
+
+    // takes a parser from the pool, or creates one if the pool is empty
+    [[nodiscard]] std::unique_ptr<PooledJsonParser> acquire();
+
+    void release(std::unique_ptr<PooledJsonParser> parser);
+
+    size_t maxCapacity;
+    mutable std::mutex mutex;
+    std::vector<std::unique_ptr<PooledJsonParser>> parsers;
+};
+
+// pool shared by the whole process
+[[nodiscard]] JsonParserPool &jsonParserPool();
+
+// reserves the padding simdjson needs after the string, and returns a view of the string with its padding
+// the view is valid until the string is modified
+[[nodiscard]] simdjson::padded_string_view padString(std::string &string);
 } // namespace xrit_unreal
 
 #endif // XRIT_UNREAL_PARSE_JSON_H
\ No newline at end of file
@@ -0,0 +1,246 @@
+#ifndef XRIT_UNREAL_BINARY_H
+#define XRIT_UNREAL_BINARY_H
+
+#include "../guid.h"
+#include "../string_arena.h"
+#include "reflect.h"
+
+#include <string>
+#include <string_view>
+
+// compact binary format for reflected types, as an alternative to json (see serialize.h and parse.h)
+//
+// the format is not self describing: there are no keys or type tags, so both sides need the same reflected types
+//   bool:           1 byte (0 or 1)
+//   uint64_t:       varint (LEB128, 7 bits per byte, least significant first)
+//   int64_t:        zigzag encoded varint, so that small negative numbers are small as well
+//   float / double: 4 / 8 bytes, little endian
+//   string:         varint size, followed by the bytes
+//   guid:           a, b, c, d as 4 bytes each, little endian
+//   enum:           varint of the enum value
+//   vector:         varint entry count, followed by the entries
+//   unordered map:  varint entry count, followed by the key and value of each entry
+//   variant:        varint index of the alternative (0 is std::monostate), followed by the fields of the alternative
+//   class:          the reflected fields in declaration order
+namespace xrit_unreal
+{
+// reads the binary format from data, values are parsed in place (like parse in parse.h)
+// string views in the parsed values reference data, unless arena is set, then they reference copies in the arena
+class BinaryReader
+{
+public:
+    explicit BinaryReader(std::string_view data, StringArena *arena = nullptr);
+
+    [[nodiscard]] bool readVarint(uint64_t &out);
+
+    // returns a view of the next size bytes
+    [[nodiscard]] bool readBytes(size_t size, std::string_view &out);
+
+    // number of bytes that have not been read yet
+    [[nodiscard]] size_t remaining() const;
+
+    StringArena *arena;
+
+private:
+    std::string_view data;
+    size_t position = 0;
+};
+
+void writeVarint(uint64_t value, std::string &out);
+
+// built-in types (declarations only)
+// serializeBinary appends the value to out, parseBinary returns false if the data is invalid or ends too early
+
+void serializeBinary(bool value, std::string &out);
+void serializeBinary(float value, std::string &out);
+void serializeBinary(double value, std::string &out);
+void serializeBinary(int64_t value, std::string &out);
+void serializeBinary(uint64_t value, std::string &out);
+void serializeBinary(std::string_view value, std::string &out);
+void serializeBinary(Guid const &value, std::string &out);
+
+[[nodiscard]] bool parseBinary(BinaryReader &reader, bool &out);
+[[nodiscard]] bool parseBinary(BinaryReader &reader, float &out);
+[[nodiscard]] bool parseBinary(BinaryReader &reader, double &out);
+[[nodiscard]] bool parseBinary(BinaryReader &reader, int64_t &out);
+[[nodiscard]] bool parseBinary(BinaryReader &reader, uint64_t &out);
+[[nodiscard]] bool parseBinary(BinaryReader &reader, std::string_view &out);
+[[nodiscard]] bool parseBinary(BinaryReader &reader, Guid &out);
+
+// forward declarations, so that nested containers of built-in types find each other
+template <typename T> std::enable_if_t<std::is_enum_v<T>, void> serializeBinary(T const &value, std::string &out);
+template <typename T> std::enable_if_t<IsVector<T>::value, void> serializeBinary(T const &value, std::string &out);
+template <typename T>
+std::enable_if_t<IsUnorderedMap<T>::value, void> serializeBinary(T const &value, std::string &out);
+template <typename T> std::enable_if_t<IsVariant<T>::value, void> serializeBinary(T const &value, std::string &out);
+template <typename T> std::enable_if_t<IsClass<T>::value, void> serializeBinary(T const &value, std::string &out);
+
+template <typename T> std::enable_if_t<std::is_enum_v<T>, bool> parseBinary(BinaryReader &reader, T &out);
+template <typename T> std::enable_if_t<IsVector<T>::value, bool> parseBinary(BinaryReader &reader, T &out);
+template <typename T> std::enable_if_t<IsUnorderedMap<T>::value, bool> parseBinary(BinaryReader &reader, T &out);
+template <typename T> std::enable_if_t<IsVariant<T>::value, bool> parseBinary(BinaryReader &reader, T &out);
+template <typename T> std::enable_if_t<IsClass<T>::value, bool> parseBinary(BinaryReader &reader, T &out);
+
+// serialize default (disabled)
+template <typename T> std::enable_if_t<IsDefault<T>::value, void> serializeBinary(T const &, std::string &)
+{
+    // static_assert(!sizeof(T)) makes sure the failure only happens when the template is instantiated, rather than
+    // always
+    static_assert(!sizeof(T), "serializeBinary() not implemented for type");
+}
+
+// parse default (disabled)
+template <typename T> std::enable_if_t<IsDefault<T>::value, bool> parseBinary(BinaryReader &, T &)
+{
+    static_assert(!sizeof(T), "parseBinary() not implemented for type");
+}
+
+// enum
+template <typename T> std::enable_if_t<std::is_enum_v<T>, void> serializeBinary(T const &value, std::string &out)
+{
+    writeVarint(static_cast<uint64_t>(value), out);
+}
+
+template <typename T> std::enable_if_t<std::is_enum_v<T>, bool> parseBinary(BinaryReader &reader, T &out)
+{
+    uint64_t value;
+    if (!reader.readVarint(value) || value == static_cast<uint64_t>(T::Invalid) ||
+        value >= static_cast<uint64_t>(T::Count))
+    {
+        return false;
+    }
+    out = static_cast<T>(value);
+    return true;
+}
+
+// vector
+template <typename T> std::enable_if_t<IsVector<T>::value, void> serializeBinary(T const &value, std::string &out)
+{
+    writeVarint(value.size(), out);
+    for (auto const &entry : value)
+    {
+        serializeBinary(entry, out);
+    }
+}
+
+template <typename T> std::enable_if_t<IsVector<T>::value, bool> parseBinary(BinaryReader &reader, T &out)
+{
+    uint64_t count;
+    if (!reader.readVarint(count))
+    {
+        return false;
+    }
+    out.clear();
+    // an invalid count can't make us reserve more than one entry per remaining byte
+    out.reserve(std::min<uint64_t>(count, reader.remaining()));
+    for (uint64_t i = 0; i < count; i++)
+    {
+        if (!parseBinary(reader, out.emplace_back()))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// unordered map
+template <typename T>
+std::enable_if_t<IsUnorderedMap<T>::value, void> serializeBinary(T const &value, std::string &out)
+{
+    writeVarint(value.size(), out);
+    for (auto const &[key, entryValue] : value)
+    {
+        serializeBinary(key, out);
+        serializeBinary(entryValue, out);
+    }
+}
+
+template <typename T> std::enable_if_t<IsUnorderedMap<T>::value, bool> parseBinary(BinaryReader &reader, T &out)
+{
+    using KeyType = typename T::key_type;
+
+    uint64_t count;
+    if (!reader.readVarint(count))
+    {
+        return false;
+    }
+    out.clear();
+    for (uint64_t i = 0; i < count; i++)
+    {
+        KeyType key{};
+        if (!parseBinary(reader, key) || !parseBinary(reader, out[key]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// variant
+template <typename T> std::enable_if_t<IsVariant<T>::value, void> serializeBinary(T const &value, std::string &out)
+{
+    writeVarint(value.index(), out);
+    auto trySerialize = [&]<size_t Index>() {
+        if (value.index() != Index)
+        {
+            return false;
+        }
+        serializeBinary(*std::get_if<Index>(&value), out);
+        return true;
+    };
+    [&]<size_t... Indices>(std::index_sequence<Indices...>) {
+        (trySerialize.template operator()<Indices + 1>() || ...);
+    }(std::make_index_sequence<std::variant_size_v<T> - 1>{}); // monostate has no fields
+}
+
+template <typename T> std::enable_if_t<IsVariant<T>::value, bool> parseBinary(BinaryReader &reader, T &out)
+{
+    uint64_t index;
+    if (!reader.readVarint(index) || index >= std::variant_size_v<T>)
+    {
+        return false;
+    }
+    if (index == 0)
+    {
+        out.template emplace<std::monostate>();
+        return true;
+    }
+
+    bool success = true;
+    auto tryParse = [&]<size_t Index>() {
+        if (index != Index)
+        {
+            return false;
+        }
+        // parse into the alternative out already holds, so that it does not have to be constructed again
+        auto *alternative = std::get_if<Index>(&out);
+        success = parseBinary(reader, alternative != nullptr ? *alternative : out.template emplace<Index>());
+        return true;
+    };
+    [&]<size_t... Indices>(std::index_sequence<Indices...>) {
+        (tryParse.template operator()<Indices + 1>() || ...);
+    }(std::make_index_sequence<std::variant_size_v<T> - 1>{});
+    return success;
+}
+
+// class
+template <typename T> std::enable_if_t<IsClass<T>::value, void> serializeBinary(T const &value, std::string &out)
+{
+    std::apply([&](auto &&...fields) { (serializeBinary(value.*fields.value, out), ...); }, classInfo<T>().fields);
+}
+
+template <typename T> std::enable_if_t<IsClass<T>::value, bool> parseBinary(BinaryReader &reader, T &out)
+{
+    return std::apply([&](auto &&...fields) { return (parseBinary(reader, out.*fields.value) && ...); },
+                      classInfo<T>().fields);
+}
+
+// parses all of data into out (in place, see above), returns false if data is invalid or has bytes left after out
+template <typename T> [[nodiscard]] bool parseBinary(std::string_view data, T &out, StringArena *arena = nullptr)
+{
+    BinaryReader reader(data, arena);
+    return parseBinary(reader, out) && reader.remaining() == 0;
+}
+} // namespace xrit_unreal
+
+#endif // XRIT_UNREAL_BINARY_H
@@ -0,0 +1,517 @@
+#ifndef XRIT_UNREAL_DIFF_H
+#define XRIT_UNREAL_DIFF_H
+
+#include "../guid.h"
+#include "../parse_json.h"
+#include "../string_arena.h"
+#include "parse.h"
+#include "reflect.h"
+#include "serialize.h"
+
+#include <algorithm>
+#include <charconv>
+#include <concepts>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// field level differences between two values of a reflected type, that can be applied to a value as a patch
+//
+// a diff is a list of operations, like a json patch (RFC 6902): each operation has a json pointer (RFC 6901) to the
+// value that changed, and for add and replace the new value as json. the differences are found by walking classInfo:
+//   class:         the fields are compared one by one
+//   vector:        entries that have a guid id (see HasGuidKey) are matched by id, and addressed by their id instead of
+//                  their index, so that adding or removing one source does not change the path of the others. the
+//                  order of these entries is not part of the diff. other vectors are compared by index, with entries
+//                  added or removed at the end
+//   unordered map: entries are matched by key
+//   variant:       if both hold the same alternative its fields are compared, otherwise the variant is replaced
+//   other values:  replaced when not equal
+namespace xrit_unreal
+{
+enum class DiffOperationType
+{
+    Add,
+    Remove,
+    Replace
+};
+
+struct DiffOperation
+{
+    DiffOperationType type;
+    std::string path;  // json pointer to the value, relative to the diffed value
+    std::string value; // json of the new value, empty for remove
+};
+
+using Diff = std::vector<DiffOperation>;
+
+// vectors of values with a guid `id` (or variants of those) are diffed by id instead of by index
+template <typename T>
+struct HasGuidKey : std::bool_constant<requires(T const &value) {
+    { value.id } -> std::same_as<Guid const &>;
+}>
+{
+};
+
+template <typename... Types>
+struct HasGuidKey<std::variant<std::monostate, Types...>> : std::bool_constant<(HasGuidKey<Types>::value && ...)>
+{
+};
+
+template <typename T> [[nodiscard]] Guid guidKey(T const &value)
+{
+    if constexpr (IsVariant<T>::value)
+    {
+        return std::visit(
+            [](auto const &alternative) -> Guid {
+                if constexpr (std::is_same_v<std::decay_t<decltype(alternative)>, std::monostate>)
+                {
+                    return Guid{};
+                }
+                else
+                {
+                    return alternative.id;
+                }
+            },
+            value);
+    }
+    else
+    {
+        return value.id;
+    }
+}
+
+// state that is passed by reference through the diff functions
+// keeps track of the path to the current value as a stack of segments, which is only formatted as json pointer when an
+// operation is added, so that comparing equal values does not format paths
+class DiffContext
+{
+public:
+    explicit DiffContext(Diff &out);
+
+    // adds an operation for the current value
+    void add(DiffOperationType type, std::string value = {});
+
+    // pushes the field key, index, or guid of a keyed entry to the path for the lifetime of the scope
+    class PathScope
+    {
+    public:
+        PathScope(DiffContext &context, std::string_view key) : context(context)
+        {
+            context.path.push_back(PathFrame{.key = key});
+        }
+
+        PathScope(DiffContext &context, uint64_t index) : context(context)
+        {
+            context.path.push_back(PathFrame{.type = PathFrame::Type::Index, .index = index});
+        }
+
+        PathScope(DiffContext &context, Guid guid) : context(context)
+        {
+            context.path.push_back(PathFrame{.type = PathFrame::Type::Guid, .guid = guid});
+        }
+
+        ~PathScope()
+        {
+            context.path.pop_back();
+        }
+
+        PathScope(PathScope const &) = delete;
+        PathScope &operator=(PathScope const &) = delete;
+
+    private:
+        DiffContext &context;
+    };
+
+private:
+    struct PathFrame
+    {
+        enum class Type : uint8_t
+        {
+            Key,
+            Index,
+            Guid
+        };
+
+        Type type = Type::Key;
+        std::string_view key{};
+        uint64_t index = 0;
+        Guid guid{};
+    };
+
+    [[nodiscard]] std::string jsonPointer() const;
+
+    Diff &out;
+    std::vector<PathFrame> path;
+};
+
+namespace internal
+{
+// values that are compared as a whole
+template <typename T>
+inline constexpr bool isDiffLeaf =
+    !std::is_class_v<T> || std::is_same_v<T, std::string_view> || std::is_same_v<T, Guid>;
+
+template <typename T> [[nodiscard]] std::string toJson(T const &value)
+{
+    return serializeToString(value);
+}
+
+template <typename T> void diffValue(T const &before, T const &after, DiffContext &context);
+
+template <typename T> void diffKeyedVector(T const &before, T const &after, DiffContext &context)
+{
+    // entries are usually in the same order, so entries are only looked up by id once they are not
+    std::unordered_map<Guid, size_t> beforeIndices;
+    bool indexed = false;
+    std::vector<bool> matched(before.size(), false);
+
+    for (size_t i = 0; i < after.size(); i++)
+    {
+        Guid key = guidKey(after[i]);
+        size_t beforeIndex = before.size();
+        if (i < before.size() && guidKey(before[i]) == key)
+        {
+            beforeIndex = i;
+        }
+        else
+        {
+            if (!indexed)
+            {
+                beforeIndices.reserve(before.size());
+                for (size_t j = 0; j < before.size(); j++)
+                {
+                    beforeIndices.try_emplace(guidKey(before[j]), j);
+                }
+                indexed = true;
+            }
+            auto it = beforeIndices.find(key);
+            if (it != beforeIndices.end())
+            {
+                beforeIndex = it->second;
+            }
+        }
+
+        DiffContext::PathScope scope(context, key);
+        if (beforeIndex == before.size() || matched[beforeIndex])
+        {
+            context.add(DiffOperationType::Add, toJson(after[i]));
+        }
+        else
+        {
+            matched[beforeIndex] = true;
+            diffValue(before[beforeIndex], after[i], context);
+        }
+    }
+
+    for (size_t j = 0; j < before.size(); j++)
+    {
+        if (!matched[j])
+        {
+            DiffContext::PathScope scope(context, guidKey(before[j]));
+            context.add(DiffOperationType::Remove);
+        }
+    }
+}
+
+// adds the operations that turn before into after to the context
+template <typename T> void diffValue(T const &before, T const &after, DiffContext &context)
+{
+    if constexpr (IsVector<T>::value)
+    {
+        if constexpr (HasGuidKey<typename T::value_type>::value)
+        {
+            diffKeyedVector(before, after, context);
+        }
+        else
+        {
+            size_t commonSize = std::min(before.size(), after.size());
+            for (size_t i = 0; i < commonSize; i++)
+            {
+                DiffContext::PathScope scope(context, uint64_t{i});
+                diffValue(before[i], after[i], context);
+            }
+            for (size_t i = commonSize; i < after.size(); i++)
+            {
+                DiffContext::PathScope scope(context, uint64_t{i});
+                context.add(DiffOperationType::Add, toJson(after[i]));
+            }
+            // remove from the back, so that the indices stay valid when the operations are applied in order
+            for (size_t i = before.size(); i > commonSize; i--)
+            {
+                DiffContext::PathScope scope(context, uint64_t{i - 1});
+                context.add(DiffOperationType::Remove);
+            }
+        }
+    }
+    else if constexpr (IsUnorderedMap<T>::value)
+    {
+        for (auto const &[key, value] : after)
+        {
+            DiffContext::PathScope scope(context, key);
+            auto it = before.find(key);
+            if (it == before.end())
+            {
+                context.add(DiffOperationType::Add, toJson(value));
+            }
+            else
+            {
+                diffValue(it->second, value, context);
+            }
+        }
+        for (auto const &[key, value] : before)
+        {
+            if (!after.contains(key))
+            {
+                DiffContext::PathScope scope(context, key);
+                context.add(DiffOperationType::Remove);
+            }
+        }
+    }
+    else if constexpr (IsVariant<T>::value)
+    {
+        if (before.index() != after.index())
+        {
+            context.add(DiffOperationType::Replace, toJson(after));
+            return;
+        }
+        auto tryDiff = [&]<size_t Index>() {
+            if (after.index() != Index)
+            {
+                return false;
+            }
+            diffValue(*std::get_if<Index>(&before), *std::get_if<Index>(&after), context);
+            return true;
+        };
+        [&]<size_t... Indices>(std::index_sequence<Indices...>) {
+            (tryDiff.template operator()<Indices + 1>() || ...);
+        }(std::make_index_sequence<std::variant_size_v<T> - 1>{}); // monostate has no fields
+    }
+    else if constexpr (!isDiffLeaf<T>)
+    {
+        // class
+        std::apply(
+            [&](auto const &...fields) {
+                (
+                    [&] {
+                        DiffContext::PathScope scope(context, fields.key);
+                        diffValue(before.*fields.value, after.*fields.value, context);
+                    }(),
+                    ...);
+            },
+            classInfo<T>().fields);
+    }
+    else
+    {
+        if (!(before == after))
+        {
+            context.add(DiffOperationType::Replace, toJson(after));
+        }
+    }
+}
+
+// parses the json of an operation into out, with the strings stored in the arena of the context
+template <typename T> bool parseOperationValue(std::string_view json, T &out, ParseContext &context)
+{
+    // wrapped in an array, because simdjson can't iterate a document that is a single number, string or bool as value
+    std::string wrapped;
+    wrapped.reserve(json.size() + 2 + simdjson::SIMDJSON_PADDING);
+    wrapped += '[';
+    wrapped += json;
+    wrapped += ']';
+
+    PooledJsonDocument document;
+    simdjson::ondemand::array array;
+    simdjson::ondemand::value value;
+    if (jsonParserPool().parse(padString(wrapped), document) != simdjson::SUCCESS ||
+        document.document.get_array().get(array) != simdjson::SUCCESS ||
+        (*array.begin()).get(value) != simdjson::SUCCESS)
+    {
+        return false;
+    }
+    return xrit_unreal::parse(value, out, context); // not internal::parse
+}
+
+template <typename T>
+bool applyOperation(T &value, std::string_view path, DiffOperation const &operation, ParseContext &context);
+
+// applies the operation to the field or entry of value at the first segment of path (path is not empty)
+template <typename T>
+bool applyOperationToChild(T &value, std::string_view path, DiffOperation const &operation, ParseContext &context)
+{
+    // split off the first segment of the path
+    if (path[0] != '/')
+    {
+        return false;
+    }
+    path.remove_prefix(1);
+    size_t end = std::min(path.find('/'), path.size());
+    std::string_view segment = path.substr(0, end);
+    std::string_view remainingPath = path.substr(end);
+    bool isTarget = remainingPath.empty(); // whether the operation adds or removes the entry of this segment
+
+    if constexpr (IsVector<T>::value)
+    {
+        using Entry = typename T::value_type;
+        size_t index = value.size();
+        if constexpr (HasGuidKey<Entry>::value)
+        {
+            Guid key;
+            if (!tryParseGuid(segment, key).empty())
+            {
+                return false;
+            }
+            auto isEntry = [&](Entry const &entry) { return guidKey(entry) == key; };
+            index = std::find_if(value.begin(), value.end(), isEntry) - value.begin();
+            if (isTarget && operation.type == DiffOperationType::Add)
+            {
+                // the order of keyed entries is not part of the diff, so new entries are added at the end
+                return parseOperationValue(operation.value, index == value.size() ? value.emplace_back() : value[index],
+                                           context);
+            }
+        }
+        else
+        {
+            auto [pointer, error] = std::from_chars(segment.data(), segment.data() + segment.size(), index);
+            if (error != std::errc() || pointer != segment.data() + segment.size())
+            {
+                return false;
+            }
+            if (isTarget && operation.type == DiffOperationType::Add)
+            {
+                if (index > value.size())
+                {
+                    return false;
+                }
+                return parseOperationValue(operation.value, *value.emplace(value.begin() + index), context);
+            }
+        }
+
+        if (index >= value.size())
+        {
+            return false;
+        }
+        if (isTarget && operation.type == DiffOperationType::Remove)
+        {
+            value.erase(value.begin() + index);
+            return true;
+        }
+        return applyOperation(value[index], remainingPath, operation, context);
+    }
+    else if constexpr (IsUnorderedMap<T>::value)
+    {
+        std::string unescaped;
+        typename T::key_type key{};
+        if (!unescapeJsonPointerSegment(segment, unescaped) || !parseStringView(unescaped, key, context))
+        {
+            return false;
+        }
+        if (isTarget && operation.type == DiffOperationType::Add)
+        {
+            return parseOperationValue(operation.value, value[key], context);
+        }
+        auto it = value.find(key);
+        if (it == value.end())
+        {
+            return false;
+        }
+        if (isTarget && operation.type == DiffOperationType::Remove)
+        {
+            value.erase(it);
+            return true;
+        }
+        return applyOperation(it->second, remainingPath, operation, context);
+    }
+    else if constexpr (!isDiffLeaf<T>)
+    {
+        // class, fields can only be replaced
+        static constexpr auto fields = classInfo<T>().fields;
+        std::string unescaped;
+        if (!unescapeJsonPointerSegment(segment, unescaped) ||
+            (isTarget && operation.type != DiffOperationType::Replace))
+        {
+            return false;
+        }
+        size_t index = fieldLookup<T>.find(unescaped);
+        bool success = false;
+        auto tryApply = [&]<size_t Index>() {
+            if (index != Index)
+            {
+                return false;
+            }
+            success = applyOperation(value.*std::get<Index>(fields).value, remainingPath, operation, context);
+            return true;
+        };
+        [&]<size_t... Indices>(std::index_sequence<Indices...>) {
+            (void)(tryApply.template operator()<Indices>() || ...);
+        }(std::make_index_sequence<std::tuple_size_v<decltype(fields)>>{});
+        return success;
+    }
+    else
+    {
+        // the path continues, but the value has no fields or entries
+        return false;
+    }
+}
+
+// applies the operation to the value at path (relative to value)
+template <typename T>
+bool applyOperation(T &value, std::string_view path, DiffOperation const &operation, ParseContext &context)
+{
+    if (path.empty())
+    {
+        return operation.type != DiffOperationType::Remove && parseOperationValue(operation.value, value, context);
+    }
+
+    if constexpr (IsVariant<T>::value)
+    {
+        // the path continues in the fields of the alternative the variant holds
+        bool success = false;
+        auto tryApply = [&]<size_t Index>() {
+            if (value.index() != Index)
+            {
+                return false;
+            }
+            success = applyOperation(*std::get_if<Index>(&value), path, operation, context);
+            return true;
+        };
+        [&]<size_t... Indices>(std::index_sequence<Indices...>) {
+            (tryApply.template operator()<Indices + 1>() || ...);
+        }(std::make_index_sequence<std::variant_size_v<T> - 1>{});
+        return success;
+    }
+    else
+    {
+        return applyOperationToChild(value, path, operation, context);
+    }
+}
+} // namespace internal
+
+// returns the operations that turn before into after
+template <typename T> [[nodiscard]] Diff diff(T const &before, T const &after)
+{
+    Diff out;
+    DiffContext context(out);
+    internal::diffValue(before, after, context);
+    return out;
+}
+
+// applies the operations of the diff to value in order
+// the strings of added and replaced values are copied into strings, so that value does not reference the diff
+// returns false if an operation could not be applied (its path does not exist, or its value is invalid), the
+// operations before it have been applied
+template <typename T> [[nodiscard]] bool patch(T &value, Diff const &diff, StringArena &strings)
+{
+    ParseContext context(ParseErrors::defaultMaxCount, &strings);
+    for (DiffOperation const &operation : diff)
+    {
+        if (!internal::applyOperation(value, operation.path, operation, context))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace xrit_unreal
+
+#endif // XRIT_UNREAL_DIFF_H
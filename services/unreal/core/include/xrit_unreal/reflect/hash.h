@@ -0,0 +1,125 @@
+#ifndef XRIT_UNREAL_REFLECT_HASH_H
+#define XRIT_UNREAL_REFLECT_HASH_H
+
+#include "../guid.h"
+#include "reflect.h"
+
+#include <cstdint>
+#include <string_view>
+
+// 64-bit hash of a reflected value, generated from classInfo
+//
+// all reflected fields are hashed, except the fields marked with REFLECT_MUTABLE (fields that can be changed at
+// runtime, such as the base settings of a live link source, see livelink.cpp). values are combined in order with
+// combineHash, which mixes every bit of the value into every bit of the hash, so that changing any field changes the
+// hash (with a chance of 1 in 2^64 of a collision), unlike a plain `seed * 31 + hash`.
+// the hash is not stable between versions, so it should not be stored or sent
+namespace xrit_unreal
+{
+// finalizer of splitmix64, each input bit flips each output bit with a chance of about one half
+[[nodiscard]] constexpr uint64_t mixHash(uint64_t value)
+{
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+// mixHash is a bijection, so for the same seed, two different values always give a different hash
+[[nodiscard]] constexpr uint64_t combineHash(uint64_t seed, uint64_t value)
+{
+    return mixHash(seed ^ (value + 0x9E3779B97F4A7C15ull));
+}
+
+// built-in types (declarations only)
+[[nodiscard]] uint64_t hashValue(bool value, uint64_t seed);
+[[nodiscard]] uint64_t hashValue(float value, uint64_t seed);
+[[nodiscard]] uint64_t hashValue(double value, uint64_t seed);
+[[nodiscard]] uint64_t hashValue(int64_t value, uint64_t seed);
+[[nodiscard]] uint64_t hashValue(uint64_t value, uint64_t seed);
+[[nodiscard]] uint64_t hashValue(std::string_view value, uint64_t seed);
+[[nodiscard]] uint64_t hashValue(Guid const &value, uint64_t seed);
+
+// forward declarations, so that nested containers of built-in types find each other
+template <typename T>
+[[nodiscard]] std::enable_if_t<std::is_enum_v<T>, uint64_t> hashValue(T const &value, uint64_t seed);
+template <typename T>
+[[nodiscard]] std::enable_if_t<IsVector<T>::value, uint64_t> hashValue(T const &value, uint64_t seed);
+template <typename T>
+[[nodiscard]] std::enable_if_t<IsUnorderedMap<T>::value, uint64_t> hashValue(T const &value, uint64_t seed);
+template <typename T>
+[[nodiscard]] std::enable_if_t<IsVariant<T>::value, uint64_t> hashValue(T const &value, uint64_t seed);
+template <typename T>
+[[nodiscard]] std::enable_if_t<IsClass<T>::value, uint64_t> hashValue(T const &value, uint64_t seed = 0);
+
+// default (disabled)
+template <typename T> std::enable_if_t<IsDefault<T>::value, uint64_t> hashValue(T const &, uint64_t)
+{
+    static_assert(!sizeof(T), "hashValue() not implemented for type");
+}
+
+// enum
+template <typename T> std::enable_if_t<std::is_enum_v<T>, uint64_t> hashValue(T const &value, uint64_t seed)
+{
+    return combineHash(seed, static_cast<uint64_t>(value));
+}
+
+// vector
+template <typename T> std::enable_if_t<IsVector<T>::value, uint64_t> hashValue(T const &value, uint64_t seed)
+{
+    seed = combineHash(seed, value.size()); // so that [[a], []] and [[], [a]] differ
+    for (auto const &entry : value)
+    {
+        seed = hashValue(entry, seed);
+    }
+    return seed;
+}
+
+// unordered map
+template <typename T> std::enable_if_t<IsUnorderedMap<T>::value, uint64_t> hashValue(T const &value, uint64_t seed)
+{
+    // the order of the entries is not part of the value, so the entries are hashed separately and summed
+    uint64_t sum = 0;
+    for (auto const &[key, entryValue] : value)
+    {
+        sum += hashValue(entryValue, hashValue(key, 0));
+    }
+    return combineHash(combineHash(seed, value.size()), sum);
+}
+
+// variant
+template <typename T> std::enable_if_t<IsVariant<T>::value, uint64_t> hashValue(T const &value, uint64_t seed)
+{
+    seed = combineHash(seed, value.index());
+    auto tryHash = [&]<size_t Index>() {
+        if (value.index() != Index)
+        {
+            return false;
+        }
+        seed = hashValue(*std::get_if<Index>(&value), seed);
+        return true;
+    };
+    [&]<size_t... Indices>(std::index_sequence<Indices...>) {
+        (tryHash.template operator()<Indices + 1>() || ...);
+    }(std::make_index_sequence<std::variant_size_v<T> - 1>{}); // monostate has no fields
+    return seed;
+}
+
+// class
+template <typename T> std::enable_if_t<IsClass<T>::value, uint64_t> hashValue(T const &value, uint64_t seed)
+{
+    [&]<size_t... Indices>(std::index_sequence<Indices...>) {
+        (
+            [&] {
+                constexpr auto field = std::get<Indices>(classInfo<T>().fields);
+                if constexpr (!field.isMutable)
+                {
+                    seed = hashValue(value.*field.value, seed);
+                }
+            }(),
+            ...);
+    }(std::make_index_sequence<std::tuple_size_v<decltype(classInfo<T>().fields)>>{});
+    return seed;
+}
+} // namespace xrit_unreal
+
+#endif // XRIT_UNREAL_REFLECT_HASH_H
@@ -3,115 +3,296 @@
 
 #include "../data/parse_error.h"
 #include "../guid.h"
-#include "../utility.h"
+#include "../parse_json.h"
+#include "../string_arena.h"
 #include "reflect.h"
 
 #include <simdjson.h>
 
+#include <array>
+#include <bitset>
 #include <charconv>
+#include <cstring>
+#include <forward_list>
+#include <string>
+#include <vector>
 
 namespace xrit_unreal
 {
 [[nodiscard]] ParseErrorCode convert(simdjson::error_code code);
 
-// creates a parse error from a simdjson error
+// accumulates the errors of parsing a json value
+// the first inlineCapacity errors are stored inline, so that parsing valid json does not allocate. Once maxCount errors
+// have been recorded, further errors are dropped and the parse functions stop early.
+// errors can reference strings owned by ParseErrors (e.g. formatted messages), so it can be moved but not copied
+class ParseErrors
+{
+public:
+    static constexpr size_t inlineCapacity = 4;
+    static constexpr size_t defaultMaxCount = 64;
+
+    explicit ParseErrors(size_t maxCount = defaultMaxCount);
+
+    ParseErrors(ParseErrors const &) = delete;
+    ParseErrors &operator=(ParseErrors const &) = delete;
+    ParseErrors(ParseErrors &&) noexcept = default;
+    ParseErrors &operator=(ParseErrors &&) noexcept = default;
+
+    // records the error, unless full
+    void add(ParseError const &error);
+
+    // stores the string for as long as ParseErrors exists, so that errors can reference it
+    [[nodiscard]] std::string_view store(std::string string);
+
+    // whether maxCount errors have been recorded
+    [[nodiscard]] bool full() const;
+
+    [[nodiscard]] bool empty() const;
+
+    [[nodiscard]] size_t size() const;
+
+    [[nodiscard]] ParseError const &operator[](size_t index) const;
+
+    [[nodiscard]] ParseError const *begin() const;
+
+    [[nodiscard]] ParseError const *end() const;
+
+    // copies the errors, the copies are only valid as long as this ParseErrors exists
+    [[nodiscard]] std::vector<ParseError> toVector() const;
+
+private:
+    size_t count = 0;
+    size_t maxCount;
+    std::array<ParseError, inlineCapacity> inlineErrors{};
+    std::vector<ParseError> heapErrors; // contains all errors once there are more than inlineCapacity
+    std::forward_list<std::string> ownedStrings; // forward_list, so that moving keeps the strings at the same address
+};
+
+// appends "/" and the key, escaped according to RFC 6901 (json pointer), to out
+void appendJsonPointerSegment(std::string_view key, std::string &out);
+
+// reverses the escaping of appendJsonPointerSegment (without the "/"), returns false for an invalid escape
+[[nodiscard]] bool unescapeJsonPointerSegment(std::string_view segment, std::string &out);
+
+// state that is passed by reference through all parse functions
+// keeps track of the current position in the json as a stack of object keys and array indices. The position is only
+// formatted (as json pointer, e.g. "/livelink/sources/0/port") when an error is added.
+class ParseContext
+{
+public:
+    // positions deeper than maxDepth are left out of the json pointer
+    static constexpr size_t maxDepth = 32;
+
+    explicit ParseContext(size_t maxErrorCount = ParseErrors::defaultMaxCount, StringArena *arena = nullptr);
+
+    ParseErrors errors;
+
+    // if set, parsed strings (and the values of errors) are copied into the arena instead of referencing the json
+    StringArena *arena;
+
+    // adds the error with the json pointer to the current position as containing object
+    void addError(ParseError error);
+
+    // same as above, with a message that gets stored in errors
+    void addError(ParseError error, std::string message);
+
+    // json pointer to the current position
+    [[nodiscard]] std::string jsonPointer() const;
+
+    // pushes the object key or array index to the position for the lifetime of the scope
+    class PathScope
+    {
+    public:
+        PathScope(ParseContext &context, std::string_view key) : context(context)
+        {
+            context.push(PathFrame{key.data(), key.size()});
+        }
+
+        PathScope(ParseContext &context, size_t index) : context(context)
+        {
+            context.push(PathFrame{nullptr, index});
+        }
+
+        ~PathScope()
+        {
+            context.depth--;
+        }
+
+        PathScope(PathScope const &) = delete;
+        PathScope &operator=(PathScope const &) = delete;
+
+    private:
+        ParseContext &context;
+    };
+
+private:
+    // either an object key or an array index (key is nullptr), without initializers so that the path is not
+    // initialized for every parse
+    struct PathFrame
+    {
+        char const *key;
+        size_t sizeOrIndex;
+    };
+
+    void push(PathFrame frame)
+    {
+        if (depth < maxDepth)
+        {
+            path[depth] = frame;
+        }
+        depth++;
+    }
+
+    std::array<PathFrame, maxDepth> path;
+    size_t depth = 0;
+};
+
+// message for a value that is not of type T, built at compile time so that it does not need to be stored in the errors
 template <typename T>
-[[nodiscard]] ParseError createError(simdjson::error_code code, simdjson::ondemand::value value,
-                                     std::string_view containingObjectName)
+constexpr auto incorrectTypeMessage = FixedString("Expected field to be of type ") + typeNameString<T>;
+
+// records a parse error from a simdjson error
+template <typename T> void addError(ParseContext &context, simdjson::error_code code, simdjson::ondemand::value value)
 {
     if (code == simdjson::INCORRECT_TYPE)
     {
-        std::ostringstream message;
-        message << "Expected field to be of type " << typeName<T>();
-        return ParseError{ParseErrorCode::InvalidValue, containingObjectName, value.raw_json_token(), message.str()};
+        context.addError(
+            ParseError{ParseErrorCode::InvalidValue, {}, value.raw_json_token(), incorrectTypeMessage<T>.view()});
     }
     else
     {
-        return ParseError{convert(code), containingObjectName, value.raw_json_token(), simdjson::error_message(code)};
+        context.addError(ParseError{convert(code), {}, value.raw_json_token(), simdjson::error_message(code)});
     }
 }
 
 // parse function signature:
-// std::vector<ParseError> parse(simdjson::ondemand::value, T& out, std::string_view containingObjectName);
+// bool parse(simdjson::ondemand::value, T& out, ParseContext& context);
+// errors are added to context, returns true if no errors occurred while parsing the value
+//
+// values are parsed in place into out, reusing its storage (e.g. the capacity of vectors): fields of a class that are
+// not in the json are reset to their default value, and vectors and maps are replaced by the entries in the json, so a
+// successful parse gives the same value as parsing into T{}. on error, out is left partially filled.
 
 // parse default (disabled)
 template <typename T>
-[[nodiscard]] std::enable_if_t<IsDefault<T>::value, std::vector<ParseError>> parse(simdjson::ondemand::value, T &,
-                                                                                   std::string_view)
+std::enable_if_t<IsDefault<T>::value, bool> parse(simdjson::ondemand::value, T &, ParseContext &)
 {
     // static_assert(!sizeof(T)) makes sure the failure only happens when the template is instantiated, rather than
     // always
     static_assert(!sizeof(T), "parse() not implemented for type");
 }
 
+struct ParseOptions
+{
+    size_t maxErrorCount = ParseErrors::defaultMaxCount;
+
+    // reset out to T{} when an error occurs, instead of leaving it partially filled
+    bool resetOnError = false;
+
+    // if set, strings are copied into the arena, so that out and the errors can outlive the json (see StringArena)
+    StringArena *arena = nullptr;
+};
+
+// parses the json value into out (in place, see above), and returns the errors
+// name is the key of the value in its containing object, used as the first segment of the json pointers of the errors
+// (empty if value is the root of the document)
+template <typename T>
+[[nodiscard]] ParseErrors parse(simdjson::ondemand::value value, T &out, std::string_view name,
+                                ParseOptions const &options = {})
+{
+    ParseContext context(options.maxErrorCount, options.arena);
+    bool success;
+    if (name.empty())
+    {
+        success = parse(value, out, context);
+    }
+    else
+    {
+        ParseContext::PathScope scope(context, name);
+        success = parse(value, out, context);
+    }
+    if (!success && options.resetOnError)
+    {
+        out = T{};
+    }
+    return std::move(context.errors);
+}
+
 // built-in types
 namespace internal
 {
 template <typename T>
-std::vector<ParseError> parse(simdjson::ondemand::value value, T &out, std::string_view containingObjectName)
+bool parse(simdjson::ondemand::value value, T &out, ParseContext &context)
 {
-    std::vector<ParseError> errors;
     auto error = value.get(out);
     if (error)
     {
-        errors.emplace_back(createError<T>(error, value, containingObjectName));
+        addError<T>(context, error, value);
+        return false;
     }
-    return errors;
+    return true;
 }
 } // namespace internal
 
 // parse bool
-[[nodiscard]] inline std::vector<ParseError> parse(simdjson::ondemand::value value, bool &out,
-                                                   std::string_view containingObjectName)
+inline bool parse(simdjson::ondemand::value value, bool &out, ParseContext &context)
 {
-    return internal::parse(value, out, containingObjectName);
+    return internal::parse(value, out, context);
 }
 
 // parse float
-[[nodiscard]] inline std::vector<ParseError> parse(simdjson::ondemand::value value, float &out,
-                                                   std::string_view containingObjectName)
+inline bool parse(simdjson::ondemand::value value, float &out, ParseContext &context)
 {
     double temporaryOut;
-    std::vector<ParseError> errors = internal::parse(value, temporaryOut, containingObjectName);
-    if (errors.empty())
+    if (!internal::parse(value, temporaryOut, context))
     {
-        out = static_cast<float>(temporaryOut);
+        return false;
     }
-    return errors;
+    out = static_cast<float>(temporaryOut);
+    return true;
 }
 
 // parse int64_t
-[[nodiscard]] inline std::vector<ParseError> parse(simdjson::ondemand::value value, int64_t &out,
-                                                   std::string_view containingObjectName)
+inline bool parse(simdjson::ondemand::value value, int64_t &out, ParseContext &context)
 {
-    return internal::parse(value, out, containingObjectName);
+    return internal::parse(value, out, context);
 }
 
 // parse uint64_t
-[[nodiscard]] inline std::vector<ParseError> parse(simdjson::ondemand::value value, uint64_t &out,
-                                                   std::string_view containingObjectName)
+inline bool parse(simdjson::ondemand::value value, uint64_t &out, ParseContext &context)
 {
-    return internal::parse(value, out, containingObjectName);
+    return internal::parse(value, out, context);
 }
 
 // parse std::string_view / parse string_view / parse string view
-[[nodiscard]] inline std::vector<ParseError> parse(simdjson::ondemand::value value, std::string_view &out,
-                                                   std::string_view containingObjectName)
+inline bool parse(simdjson::ondemand::value value, std::string_view &out, ParseContext &context)
 {
-    return internal::parse(value, out, containingObjectName);
+    if (!internal::parse(value, out, context))
+    {
+        return false;
+    }
+    if (context.arena != nullptr)
+    {
+        out = context.arena->store(out);
+    }
+    return true;
 }
 
 // parse guid
-[[nodiscard]] inline std::vector<ParseError> parse(simdjson::ondemand::value value, Guid &out,
-                                                   std::string_view containingObjectName)
+inline bool parse(simdjson::ondemand::value value, Guid &out, ParseContext &context)
 {
     std::string_view string;
-    std::vector<ParseError> errors = internal::parse(value, string, containingObjectName);
-    if (errors.empty())
+    if (!internal::parse(value, string, context))
+    {
+        return false;
+    }
+    std::string_view errorMessage = tryParseGuid(string, out);
+    if (!errorMessage.empty())
     {
-        errors = parseGuid(string, out, containingObjectName);
+        context.addError(ParseError{ParseErrorCode::InvalidValue, {}, string, errorMessage});
+        return false;
     }
-    return errors;
+    return true;
 }
 
 // parse unordered_map / dictionary keys (because keys are of type simdjson::ondemand::raw_json_string rather than
@@ -119,300 +300,399 @@ std::vector<ParseError> parse(simdjson::ondemand::value value, T &out, std::stri
 
 // default implementation:
 template <typename T>
-[[nodiscard]] std::vector<ParseError> parseStringView(std::string_view value, T &out,
-                                                      std::string_view containingObjectName)
+bool parseStringView(std::string_view value, T &out, ParseContext &context)
 {
     auto [ptr, errorCode] = std::from_chars(value.begin(), value.end(), out);
     if (errorCode != std::errc() || ptr != value.end())
     {
-        return {ParseError{ParseErrorCode::InvalidValue, containingObjectName, value}};
+        context.addError(ParseError{ParseErrorCode::InvalidValue, {}, value, "Key does not contain valid number"});
+        return false;
     }
-    return {};
+    return true;
 }
 
 // string view doesn't need to be converted
 template <>
-[[nodiscard]] inline std::vector<ParseError> parseStringView(std::string_view value, std::string_view &out,
-                                                             std::string_view containingObjectName)
+inline bool parseStringView(std::string_view value, std::string_view &out, ParseContext &context)
 {
-    out = value;
-    return {};
+    out = context.arena != nullptr ? context.arena->store(value) : value;
+    return true;
 }
 
 // Guid requires special handling (default implementation not used)
 template <>
-[[nodiscard]] inline std::vector<ParseError> parseStringView(std::string_view value, Guid &out,
-                                                             std::string_view containingObjectName)
+inline bool parseStringView(std::string_view value, Guid &out, ParseContext &context)
 {
-    return parseGuid(value, out, containingObjectName);
+    std::string_view errorMessage = tryParseGuid(value, out);
+    if (!errorMessage.empty())
+    {
+        context.addError(ParseError{ParseErrorCode::InvalidValue, {}, value, errorMessage});
+        return false;
+    }
+    return true;
 }
 
 // parse enum
 template <typename T>
-[[nodiscard]] std::enable_if_t<std::is_enum_v<T>, std::vector<ParseError>> parse(simdjson::ondemand::value value,
-                                                                                 T &out,
-                                                                                 std::string_view containingObjectName)
+std::enable_if_t<std::is_enum_v<T>, bool> parse(simdjson::ondemand::value value, T &out, ParseContext &context)
 {
     std::string_view string;
     simdjson::error_code simdjsonError = value.get(string);
     if (simdjsonError)
     {
-        return {createError<T>(simdjsonError, value, containingObjectName)};
+        addError<T>(context, simdjsonError, value);
+        return false;
     }
     T enum_ = parseEnum<T>(string);
     if (enum_ == T::Invalid)
     {
-        return {ParseError{ParseErrorCode::InvalidValue, containingObjectName, value.raw_json_token(),
-                           "invalid enum case"}};
+        context.addError(ParseError{ParseErrorCode::InvalidValue, {}, value.raw_json_token(), "invalid enum case"});
+        return false;
     }
     out = enum_;
-    return {};
+    return true;
 }
 
 // parse vector
+// number of entries reserved for a vector without capacity when parsing its first entry
+inline constexpr size_t initialVectorCapacity = 8;
+
 template <typename T>
-[[nodiscard]] std::enable_if_t<IsVector<T>::value, std::vector<ParseError>> parse(simdjson::ondemand::value value,
-                                                                                  T &out,
-                                                                                  std::string_view containingObjectName)
+std::enable_if_t<IsVector<T>::value, bool> parse(simdjson::ondemand::value value, T &out, ParseContext &context)
 {
     simdjson::ondemand::array array;
     simdjson::error_code simdjsonError = value.get(array);
     if (simdjsonError)
     {
-        return {createError<T>(simdjsonError, value, containingObjectName)};
+        addError<T>(context, simdjsonError, value);
+        return false;
     }
 
-    size_t arraySize;
-    simdjsonError = array.count_elements().get(arraySize);
-    if (simdjsonError)
-    {
-        return {createError<T>(simdjsonError, value, containingObjectName)};
-    }
+    // the array is parsed in a single pass, so its size is not known up front. out is cleared so that all entries are
+    // value initialized, while keeping its capacity, which makes out.reserve() a capacity hint for the caller. if out
+    // has no capacity, room for a few entries is reserved on the first entry, to skip the first few reallocations.
+    out.clear();
 
-    std::vector<ParseError> errors;
-    T temporaryOut(arraySize);
-    size_t i = 0;
+    bool success = true;
     for (auto entry : array)
     {
-        std::ostringstream entryName;
-        entryName << containingObjectName << "[" << i << "]";
-        std::vector<ParseError> entryErrors = parse(entry.value(), temporaryOut[i], entryName.str());
-        append(errors, entryErrors);
-        i++;
+        if (context.errors.full())
+        {
+            return false;
+        }
+        if (out.capacity() == 0)
+        {
+            out.reserve(initialVectorCapacity);
+        }
+        ParseContext::PathScope scope(context, out.size());
+        success &= parse(entry.value(), out.emplace_back(), context);
     }
-    out = std::move(temporaryOut);
-    return errors;
+    return success;
 }
 
 // parse unordered map
 template <typename T>
-[[nodiscard]] std::enable_if_t<IsUnorderedMap<T>::value, std::vector<ParseError>> parse(
-    simdjson::ondemand::value value, T &out, std::string_view containingObjectName)
+std::enable_if_t<IsUnorderedMap<T>::value, bool> parse(simdjson::ondemand::value value, T &out, ParseContext &context)
 {
     using KeyType = typename T::key_type;
-    using MappedType = typename T::mapped_type;
 
     simdjson::ondemand::object o;
     simdjson::error_code simdjsonError = value.get(o);
     if (simdjsonError)
     {
-        return {createError<T>(simdjsonError, value, containingObjectName)};
+        addError<T>(context, simdjsonError, value);
+        return false;
     }
 
-    T temporaryOut{};
-    std::vector<ParseError> errors;
+    out.clear();
+
+    bool success = true;
     // iterate over all fields in map / dictionary
     for (auto field : o)
     {
+        if (context.errors.full())
+        {
+            return false;
+        }
+
         std::string_view keyString;
         simdjsonError = field.escaped_key().get(keyString);
         if (simdjsonError)
         {
-            errors.emplace_back(createError<T>(simdjsonError, value, containingObjectName));
+            addError<T>(context, simdjsonError, value);
+            success = false;
             continue;
         }
 
         KeyType key;
-        std::vector<ParseError> keyErrors = parseStringView(keyString, key, containingObjectName);
-        if (!keyErrors.empty())
+        if (!parseStringView(keyString, key, context))
         {
-            append(errors, keyErrors);
+            success = false;
             continue;
         }
 
-        MappedType entryValue{};
-        std::vector<ParseError> valueErrors = parse(field.value(), entryValue, keyString);
-        if (!valueErrors.empty())
+        // entries that fail to parse are left out
+        auto [entry, inserted] = out.try_emplace(key);
+        ParseContext::PathScope scope(context, keyString);
+        if (!parse(field.value(), entry->second, context))
         {
-            append(errors, valueErrors);
-            continue;
+            out.erase(entry);
+            success = false;
         }
-        temporaryOut.emplace(key, entryValue);
     }
-    out = std::move(temporaryOut);
-    return errors;
+    return success;
 }
 
 // forward declaration of parse remaining class fields (used by parse variant and parse class)
 template <typename T>
-[[nodiscard]] std::vector<ParseError> parseRemainingClassFields(simdjson::ondemand::object object,
-                                                                simdjson::ondemand::object_iterator iterator, T &out,
-                                                                std::string_view containingObjectName);
+bool parseRemainingClassFields(simdjson::ondemand::object object, simdjson::ondemand::object_iterator iterator, T &out,
+                               ParseContext &context);
 
 // parse variant
 template <typename T>
-[[nodiscard]] std::enable_if_t<IsVariant<T>::value, std::vector<ParseError>> parse(
-    simdjson::ondemand::value value, T &out, std::string_view containingObjectName)
+std::enable_if_t<IsVariant<T>::value, bool> parse(simdjson::ondemand::value value, T &out, ParseContext &context)
 {
     simdjson::ondemand::object o;
     simdjson::error_code simdjsonError = value.get(o);
     if (simdjsonError)
     {
-        return {createError<T>(simdjsonError, value, containingObjectName)};
+        addError<T>(context, simdjsonError, value);
+        return false;
     }
 
     auto result = o.is_empty();
     if (result.error())
     {
-        return {createError<T>(result.error(), value, containingObjectName)};
+        addError<T>(context, result.error(), value);
+        return false;
     }
     if (result.value()) // if is empty
     {
-        out = std::monostate{};
-        return {}; // this is not an error, so we return an empty errors vector
+        out.template emplace<std::monostate>();
+        return true; // this is not an error
     }
 
     auto begin = o.begin();
     if (begin.error())
     {
-        return {createError<T>(begin.error(), value, containingObjectName)};
+        addError<T>(context, begin.error(), value);
+        return false;
     }
     auto iterator = begin.value();
 
     auto typeField = *iterator;
     if (typeField.error())
     {
-        return {createError<T>(typeField.error(), value, containingObjectName)};
+        addError<T>(context, typeField.error(), value);
+        return false;
     }
 
     std::string_view keyName;
     simdjsonError = typeField.escaped_key().get(keyName);
     if (simdjsonError)
     {
-        return {createError<T>(simdjsonError, value, containingObjectName)};
+        addError<T>(context, simdjsonError, value);
+        return false;
     }
 
     if (keyName != "$type")
     {
-        return {ParseError{ParseErrorCode::VariantTypeMissing, containingObjectName, value.raw_json_token(),
-                           "Variant should start with field $type"}};
+        context.addError(ParseError{ParseErrorCode::VariantTypeMissing, {}, value.raw_json_token(),
+                                    "Variant should start with field $type"});
+        return false;
     }
 
     std::string_view type;
     simdjsonError = typeField.value().get(type);
     if (simdjsonError)
     {
-        return {createError<T>(simdjsonError, value, containingObjectName)};
+        addError<T>(context, simdjsonError, value);
+        return false;
     }
     ++iterator;
 
-    std::vector<ParseError> errors;
-    bool found = false;
-    auto tryParse = [&]<std::size_t Index>() {
-        if (found)
-        {
-            return;
-        } // if we found the type already, don't do anything
-        using Type = std::variant_alternative_t<Index + 1, T>;
-        std::string_view variantName = classInfo<Type>().name;
-        if (variantName == type)
+    // look up the only alternative the type can be, and compare with its compile time name, so that the type is
+    // hashed once instead of compared with the name of every alternative in turn
+    constexpr auto &lookup = variantTypeLookup<T>;
+    constexpr size_t alternativeCount = std::variant_size_v<T> - 1; // without monostate
+    size_t index = lookup.candidate(type);
+
+    bool success = true;
+    auto tryParse = [&]<size_t Index>() {
+        constexpr std::string_view name = lookup.keys[Index];
+        if (index != Index || type.size() != name.size() || std::memcmp(type.data(), name.data(), name.size()) != 0)
         {
-            out = Type{};
-            auto &a = std::get<Type>(out);
-            errors = parseRemainingClassFields(o, iterator, a, containingObjectName);
-            found = true;
+            return false;
         }
+        using Type = std::variant_alternative_t<Index + 1, T>;
+        // parse into the alternative out already holds, so that it does not have to be constructed again (its fields
+        // that are not in the json are reset)
+        Type *alternative = std::get_if<Type>(&out);
+        Type &a = alternative != nullptr ? *alternative : out.template emplace<Type>();
+        success = parseRemainingClassFields(o, iterator, a, context);
+        return true;
     };
-    auto iterateIndices = [&]<std::size_t... Indices>(std::index_sequence<Indices...>) {
-        (tryParse.template operator()<Indices>(), ...);
-    };
-    constexpr size_t size = std::variant_size_v<T>;
-    iterateIndices(std::make_index_sequence<size - 1>{}); // only iterate over after monostate
+    bool found = [&]<size_t... Indices>(std::index_sequence<Indices...>) {
+        return (tryParse.template operator()<Indices>() || ...);
+    }(std::make_index_sequence<alternativeCount>{});
     if (!found)
     {
-        return {ParseError{ParseErrorCode::VariantTypeInvalid, containingObjectName, value.raw_json_token(),
-                           "Variant does not contain provided type"}};
+        context.addError(ParseError{ParseErrorCode::VariantTypeInvalid, {}, value.raw_json_token(),
+                                    "Variant does not contain provided type"});
+        return false;
     }
-    return errors;
+    return success;
 }
 
 // parse class
 template <typename T>
-[[nodiscard]] std::enable_if_t<IsClass<T>::value, std::vector<ParseError>> parse(simdjson::ondemand::value value,
-                                                                                 T &out,
-                                                                                 std::string_view containingObjectName)
+std::enable_if_t<IsClass<T>::value, bool> parse(simdjson::ondemand::value value, T &out, ParseContext &context)
 {
     simdjson::ondemand::object o;
     simdjson::error_code simdjsonError = value.get(o);
     if (simdjsonError)
     {
-        return {createError<T>(simdjsonError, value, containingObjectName)};
+        addError<T>(context, simdjsonError, value);
+        return false;
     }
-    return parseRemainingClassFields(o, o.begin(), out, containingObjectName);
+    return parseRemainingClassFields(o, o.begin(), out, context);
 }
 
 // parse remaining class fields implementation
 template <typename T>
-[[nodiscard]] std::vector<ParseError> parseRemainingClassFields(simdjson::ondemand::object object,
-                                                                simdjson::ondemand::object_iterator iterator, T &out,
-                                                                std::string_view containingObjectName)
+bool parseRemainingClassFields(simdjson::ondemand::object object, simdjson::ondemand::object_iterator iterator, T &out,
+                               ParseContext &context)
 {
-    std::vector<ParseError> errors;
-    T temporaryOut{};
+    constexpr auto &lookup = fieldLookup<T>;
+    static constexpr auto fields = classInfo<T>().fields;
+    constexpr size_t fieldCount = std::tuple_size_v<decltype(fields)>;
+
+    bool success = true;
+    size_t expectedIndex = 0;
+    std::bitset<fieldCount> seen;
 
     while (iterator != object.end())
     {
+        if (context.errors.full())
+        {
+            return false;
+        }
+
         auto field = *iterator;
 
         std::string_view keyString;
         auto simdjsonError = field.escaped_key().get(keyString);
         if (simdjsonError)
         {
-            errors.emplace_back(ParseError{convert(simdjsonError), {}, {}, simdjson::error_message(simdjsonError)});
+            context.addError(ParseError{convert(simdjsonError), {}, {}, simdjson::error_message(simdjsonError)});
+            success = false;
             ++iterator;
             continue;
         }
-        bool found = false;
-        // iterate over the fields of the reflected c++ struct and see if it contains the key of the current json object
-        // field
-        auto fields = classInfo<T>().fields;
-        std::vector<ParseError> fieldErrors;
-        auto a = [&](auto &&...args) {
-            (([&]() {
-                 if (found)
-                 {
-                     return;
-                 } // if we found the field already, don't do anything
-                 if (keyString == args.key)
-                 {
-                     found = true;
-                     fieldErrors = parse(field.value(), temporaryOut.*args.value, keyString);
-                 }
-             }()),
-             ...); // fold expression
+
+        // whether the key is the key of the field at index, compares with the compile time key so that the comparison
+        // gets inlined
+        auto isFieldKey = [&]<size_t... Indices>(size_t index, std::index_sequence<Indices...>) {
+            return ((index == Indices && keyString == std::get<Indices>(fields).key) || ...);
         };
-        std::apply(a, fields);
+
+        // json serialized from the same schema contains the fields in declaration order, so first check whether the
+        // key is the field after the previous one, and otherwise look up which field of the reflected c++ struct the
+        // key can belong to
+        size_t index = expectedIndex;
+        bool found = index < fieldCount && lookup.keys[index].size() == keyString.size() &&
+                     std::memcmp(lookup.keys[index].data(), keyString.data(), keyString.size()) == 0;
+        if (!found)
+        {
+            index = lookup.candidate(keyString);
+            found = isFieldKey(index, std::make_index_sequence<fieldCount>{});
+        }
+
         if (!found)
         {
-            errors.emplace_back(ParseError{ParseErrorCode::InvalidField, containingObjectName, keyString,
-                                           "Object does not contain provided field name"});
+            context.addError(
+                ParseError{ParseErrorCode::InvalidField, {}, keyString, "Object does not contain provided field name"});
+            success = false;
+            ++iterator;
+            continue;
         }
-        append(errors, fieldErrors);
+
+        // dispatch to the parse function of the field
+        ParseContext::PathScope scope(context, keyString);
+        auto parseField = [&]<size_t Index>() {
+            if (index != Index)
+            {
+                return false;
+            }
+            success &= parse(field.value(), out.*std::get<Index>(fields).value, context);
+            return true;
+        };
+        [&]<size_t... Indices>(std::index_sequence<Indices...>) {
+            (void)(parseField.template operator()<Indices>() || ...);
+        }(std::make_index_sequence<fieldCount>{});
+        seen.set(index);
+        expectedIndex = index + 1;
         ++iterator;
     }
-    out = std::move(temporaryOut);
-    return errors;
+
+    // out can hold values from before, which should not end up in the result. the fields are reset to the values of
+    // T{}, so that their default member initializers are kept
+    if (!seen.all())
+    {
+        static T const defaults{};
+        [&]<size_t... Indices>(std::index_sequence<Indices...>) {
+            ((seen[Indices] ? void()
+                            : void(out.*std::get<Indices>(fields).value = defaults.*std::get<Indices>(fields).value)),
+             ...);
+        }(std::make_index_sequence<fieldCount>{});
+    }
+    return success;
+}
+
+// parses a stream of json documents (concatenated, or separated by whitespace such as newline delimited json) as T,
+// in a single pass over the json. for each document, onDocument(T &value, ParseErrors &errors) is called in order,
+// value is only parsed from that document (and can be moved from). as with parse, string views in the values and errors
+// reference json, unless options.arena is set. the parser is taken from jsonParserPool().
+// every document should be smaller than batchSize. returns the error that stopped the stream (e.g. invalid utf-8), or
+// INCOMPLETE_ARRAY_OR_OBJECT if the json ends with an incomplete document, both after the documents before it have
+// been passed to onDocument
+template <typename T, typename OnDocument>
+[[nodiscard]] simdjson::error_code parseMany(simdjson::padded_string_view json, OnDocument &&onDocument,
+                                             ParseOptions const &options = {},
+                                             size_t batchSize = simdjson::dom::DEFAULT_BATCH_SIZE)
+{
+    if (json.empty())
+    {
+        // no documents (the stream does not set its truncated bytes when it has nothing to parse)
+        return simdjson::SUCCESS;
+    }
+
+    PooledJsonDocumentStream stream;
+    simdjson::error_code error = jsonParserPool().parseMany(json, batchSize, stream);
+    if (error)
+    {
+        return error;
+    }
+
+    for (auto document : stream.stream)
+    {
+        simdjson::ondemand::value value;
+        error = document.get_value().get(value);
+        if (error)
+        {
+            return error;
+        }
+        T out{};
+        ParseErrors errors = parse(value, out, "", options);
+        onDocument(out, errors);
+    }
+
+    if (stream.stream.truncated_bytes() != 0)
+    {
+        return simdjson::INCOMPLETE_ARRAY_OR_OBJECT;
+    }
+    return simdjson::SUCCESS;
 }
 } // namespace xrit_unreal
 
-#endif // XRIT_UNREAL_PARSE_H
\ No newline at end of file
+#endif // XRIT_UNREAL_PARSE_H
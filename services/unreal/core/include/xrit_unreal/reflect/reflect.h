@@ -1,11 +1,14 @@
 #ifndef XRIT_UNREAL_REFLECT_H
 #define XRIT_UNREAL_REFLECT_H
 
+#include <algorithm>
 #include <array>
+#include <bit>
 #include <cassert>
 #include <cstdint>
-#include <sstream>
+#include <cstring>
 #include <string_view>
+#include <tuple>
 #include <unordered_map>
 #include <utility>
 #include <variant>
@@ -14,6 +17,9 @@
 // simple reflection system for parsing and serializing json
 #define REFLECT_STRUCT     // write above struct to enable reflecting this struct
 #define REFLECT(Name) Name // write around the field name to enable reflecting this field
+// write around the field name instead of REFLECT for fields that can be changed at runtime, these are reflected like
+// other fields, but are not part of hashValue (see hash.h)
+#define REFLECT_MUTABLE(Name) Name
 #define REFLECT_ENUM       // write above enum to enable reflection
 
 // SFINAE helper structs
@@ -25,7 +31,8 @@ template <typename> struct IsVector : std::false_type
 {
 };
 
-template <typename T> struct IsVector<std::vector<T>> : std::true_type
+// also matches vectors with a custom allocator, such as std::pmr::vector
+template <typename T, typename Allocator> struct IsVector<std::vector<T, Allocator>> : std::true_type
 {
 };
 
@@ -65,7 +72,7 @@ struct IsClass : std::bool_constant<std::is_class_v<T> && !std::is_enum_v<T> &&
 
 // these macros can be automatically generated by generate_reflection.py, or manually if preferred
 #define REFLECT_IMPL_ENUM_BEGIN(EnumType)                                                                              \
-    template <> [[nodiscard]] auto inline xrit_unreal::enumInfo<EnumType>()                                            \
+    template <> [[nodiscard]] constexpr auto xrit_unreal::enumInfo<EnumType>()                                         \
     {                                                                                                                  \
     return EnumInfoFactory<EnumType>::create(#EnumType, std::array{
 #define REFLECT_IMPL_CASE(CaseName) std::string_view(#CaseName),
@@ -75,12 +82,13 @@ struct IsClass : std::bool_constant<std::is_class_v<T> && !std::is_enum_v<T> &&
     }
 
 #define REFLECT_IMPL_STRUCT_BEGIN(TypeName)                                                                            \
-    template <> [[nodiscard]] auto inline xrit_unreal::classInfo<TypeName>()                                           \
+    template <> [[nodiscard]] constexpr auto xrit_unreal::classInfo<TypeName>()                                        \
     {                                                                                                                  \
         using TypeNameAlias = TypeName;                                                                                \
     return ClassInfoFactory<TypeName>::create(#TypeName, std::tuple{
 
 #define REFLECT_IMPL_FIELD(FieldName) Field(#FieldName, &TypeNameAlias::FieldName),
+#define REFLECT_IMPL_MUTABLE_FIELD(FieldName) Field(#FieldName, &TypeNameAlias::FieldName, true),
 
 #define REFLECT_IMPL_STRUCT_END                                                                                        \
     });                                                                                                                \
@@ -102,7 +110,8 @@ template <typename T> auto enumInfo()
 template <typename T> struct EnumInfoFactory
 {
     template <size_t Size>
-    [[nodiscard]] static EnumInfo<T, Size> create(std::string_view name, std::array<std::string_view, Size> cases)
+    [[nodiscard]] static constexpr EnumInfo<T, Size> create(std::string_view name,
+                                                            std::array<std::string_view, Size> cases)
     {
         return EnumInfo<T, Size>{.name = name, .cases = cases};
     }
@@ -143,8 +152,10 @@ template <typename Class, typename T> struct Field
 {
     std::string_view key;
     T Class::*value; // pointer to data member
+    bool isMutable;  // marked with REFLECT_MUTABLE
 
-    Field(std::string_view key, T Class::*value) : key(key), value(value)
+    constexpr Field(std::string_view key, T Class::*value, bool isMutable = false)
+        : key(key), value(value), isMutable(isMutable)
     {
     }
 };
@@ -161,7 +172,7 @@ template <typename T, typename... Fields> struct ClassInfo
 template <typename T> struct ClassInfoFactory
 {
     template <typename... Fields>
-    [[nodiscard]] static ClassInfo<T, Fields...> create(std::string_view name, std::tuple<Fields...> fields)
+    [[nodiscard]] static constexpr ClassInfo<T, Fields...> create(std::string_view name, std::tuple<Fields...> fields)
     {
         return ClassInfo<T, Fields...>{.name = name, .fields = std::move(fields)};
     }
@@ -171,93 +182,258 @@ template <typename T> auto classInfo()
 {
 }
 
+// compile-time perfect hash table for looking up the index of a key (e.g. json key -> reflected field index) with
+// a single hash and a single string comparison, instead of comparing the key against each field in turn
+template <size_t Size> struct PerfectHashTable
+{
+    static_assert(Size < 255, "indices are stored as uint8_t");
+
+    // 4 times as many slots as keys, so that a seed without collisions is found quickly (at least 2 slots, so that the
+    // hash shift stays below 64)
+    static constexpr size_t slotCount = std::bit_ceil(Size * 4 + 2);
+    static constexpr uint8_t emptySlot = 255;
+
+    uint64_t seed = 0;
+    std::array<uint8_t, slotCount> slots{};
+    std::array<std::string_view, Size> keys{};
+
+    // reads up to 8 bytes of the key starting at offset
+    [[nodiscard]] static constexpr uint64_t read(std::string_view key, size_t offset)
+    {
+        size_t count = std::min<size_t>(8, key.size() - offset);
+        if (!std::is_constant_evaluated() && count == 8)
+        {
+            uint64_t result;
+            std::memcpy(&result, key.data() + offset, 8);
+            return result;
+        }
+        uint64_t result = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            result |= static_cast<uint64_t>(static_cast<uint8_t>(key[offset + i])) << (i * 8);
+        }
+        return result;
+    }
+
+    // only hashes the length, the first 8 bytes and the last 8 bytes, so that hashing is independent of the key length
+    // (the found key is compared with the full key afterwards), multiplicative hashing takes the upper bits
+    [[nodiscard]] static constexpr size_t hash(std::string_view key, uint64_t seed)
+    {
+        uint64_t first = read(key, 0);
+        uint64_t last = read(key, key.size() < 8 ? 0 : key.size() - 8);
+        uint64_t hash = (first ^ std::rotl(last, 29) ^ key.size()) * (0x9E3779B97F4A7C15ull + seed * 2);
+        return static_cast<size_t>(hash >> (64 - std::countr_zero(slotCount)));
+    }
+
+    // returns the index of the only key that can be equal to key, or Size if there is none
+    // the caller still has to compare the keys (which is faster when comparing with a compile time constant key)
+    [[nodiscard]] constexpr size_t candidate(std::string_view key) const
+    {
+        uint8_t index = slots[hash(key, seed)];
+        return index == emptySlot ? Size : index;
+    }
+
+    // returns the index of the key, or Size if the key does not exist
+    [[nodiscard]] constexpr size_t find(std::string_view key) const
+    {
+        size_t index = candidate(key);
+        return index != Size && keys[index] == key ? index : Size;
+    }
+};
+
+// searches (at compile time) for a seed for which all keys end up in a different slot
+// keys should be unique
+template <size_t Size>
+[[nodiscard]] constexpr PerfectHashTable<Size> createPerfectHashTable(std::array<std::string_view, Size> keys)
+{
+    using Table = PerfectHashTable<Size>;
+    Table table{.keys = keys};
+    for (uint64_t seed = 0;; seed++)
+    {
+        // if this fails to compile, two keys have the same length, first 8 and last 8 bytes (or are duplicates)
+        assert(seed < 65536 && "no perfect hash found");
+
+        table.seed = seed;
+        table.slots.fill(Table::emptySlot);
+        bool collision = false;
+        for (size_t i = 0; i < Size && !collision; i++)
+        {
+            uint8_t &slot = table.slots[Table::hash(keys[i], seed)];
+            collision = slot != Table::emptySlot;
+            slot = static_cast<uint8_t>(i);
+        }
+        if (!collision)
+        {
+            return table;
+        }
+    }
+}
+
+namespace internal
+{
+template <typename T> [[nodiscard]] constexpr auto fieldKeys()
+{
+    return std::apply([](auto &&...fields) { return std::array<std::string_view, sizeof...(fields)>{fields.key...}; },
+                      classInfo<T>().fields);
+}
+} // namespace internal
+
+// perfect hash table from the reflected field keys of T to the field index in classInfo<T>().fields
+template <typename T> constexpr auto fieldLookup = createPerfectHashTable(internal::fieldKeys<T>());
+
+namespace internal
+{
+// type names of the alternatives of variant T, except the std::monostate at index 0
+template <typename T> [[nodiscard]] constexpr auto variantTypeNames()
+{
+    return []<size_t... Indices>(std::index_sequence<Indices...>) {
+        return std::array<std::string_view, sizeof...(Indices)>{
+            classInfo<std::variant_alternative_t<Indices + 1, T>>().name...};
+    }(std::make_index_sequence<std::variant_size_v<T> - 1>{});
+}
+} // namespace internal
+
+// perfect hash table from the reflected type names of the alternatives of variant T (the $type) to the variant index
+// minus one (std::monostate is not in the table)
+template <typename T> constexpr auto variantTypeLookup = createPerfectHashTable(internal::variantTypeNames<T>());
+
+// string of a size that is known at compile time, so that it can be built in constant expressions
+template <size_t Size> struct FixedString
+{
+    std::array<char, Size> characters{};
+
+    constexpr FixedString() = default;
+
+    constexpr FixedString(char const (&string)[Size + 1])
+    {
+        std::copy_n(string, Size, characters.begin());
+    }
+
+    [[nodiscard]] constexpr std::string_view view() const
+    {
+        return {characters.data(), Size};
+    }
+};
+
+template <size_t Size> FixedString(char const (&)[Size]) -> FixedString<Size - 1>;
+
+template <size_t SizeA, size_t SizeB>
+[[nodiscard]] constexpr FixedString<SizeA + SizeB> operator+(FixedString<SizeA> const &a, FixedString<SizeB> const &b)
+{
+    FixedString<SizeA + SizeB> result;
+    std::copy_n(a.characters.begin(), SizeA, result.characters.begin());
+    std::copy_n(b.characters.begin(), SizeB, result.characters.begin() + SizeA);
+    return result;
+}
+
 namespace internal
 {
-template <typename T> void buildTypeName(std::ostringstream &out)
+// copies the string view returned by the (captureless) lambda into a fixed string, the lambda is needed because the
+// size has to be a constant expression
+template <typename GetString> [[nodiscard]] constexpr auto toFixedString(GetString)
+{
+    constexpr std::string_view string = GetString{}();
+    FixedString<string.size()> result;
+    std::copy_n(string.begin(), string.size(), result.characters.begin());
+    return result;
+}
+
+template <typename T> [[nodiscard]] constexpr auto buildTypeName()
 {
     // built in type names
     if constexpr (std::is_same_v<T, std::string_view>)
     {
-        out << "string";
+        return FixedString("string");
     }
     else if constexpr (std::is_same_v<T, bool>)
     {
-        out << "bool";
+        return FixedString("bool");
     }
     else if constexpr (std::is_same_v<T, int64_t>)
     {
-        out << "int64";
+        return FixedString("int64");
     }
     else if constexpr (std::is_same_v<T, uint64_t>)
     {
-        out << "uint64";
+        return FixedString("uint64");
     }
     else if constexpr (std::is_same_v<T, float>)
     {
-        out << "float";
+        return FixedString("float");
     }
     else if constexpr (std::is_same_v<T, double>)
     {
-        out << "double";
+        return FixedString("double");
     }
     else if constexpr (IsVector<T>::value)
     {
         using ValueType = typename T::value_type;
-        out << "list<";
-        buildTypeName<ValueType>(out);
-        out << ">";
+        return FixedString("list<") + buildTypeName<ValueType>() + FixedString(">");
     }
     else if constexpr (IsUnorderedMap<T>::value)
     {
         using KeyType = typename T::key_type;
         using MappedType = typename T::mapped_type;
-        out << "dictionary<";
-        buildTypeName<KeyType>(out);
-        out << ", ";
-        buildTypeName<MappedType>(out);
-        out << ">";
+        return FixedString("dictionary<") + buildTypeName<KeyType>() + FixedString(", ") + buildTypeName<MappedType>() +
+               FixedString(">");
     }
     else if constexpr (IsVariant<T>::value)
     {
-        out << "variant<";
-        constexpr size_t size = std::variant_size_v<T>;
-        auto addVariantName = [&]<std::size_t Index>() {
+        auto variantName = []<std::size_t Index>() {
             using Type = std::variant_alternative_t<Index + 1, T>;
-            std::string_view variantName = classInfo<Type>().name;
-            out << variantName;
-            if (Index < size - 2)
+            auto name = toFixedString([] { return classInfo<Type>().name; });
+            if constexpr (Index == 0)
+            {
+                return name;
+            }
+            else
             {
-                out << ", ";
+                return FixedString(", ") + name;
             }
         };
-        auto iterateIndices = [&]<std::size_t... Indices>(std::index_sequence<Indices...>) {
-            (addVariantName.template operator()<Indices>(), ...);
+        auto joinNames = [&]<std::size_t... Indices>(std::index_sequence<Indices...>) {
+            return (FixedString("variant<") + ... + variantName.template operator()<Indices>()) + FixedString(">");
         };
-        iterateIndices(std::make_index_sequence<size - 1>{}); // only iterate over after monostate
-        out << ">";
+        return joinNames(std::make_index_sequence<std::variant_size_v<T> - 1>{}); // only names after monostate
     }
     else if constexpr (std::is_enum_v<T>)
     {
-        out << "enum " << enumInfo<T>().name;
+        return FixedString("enum ") + toFixedString([] { return enumInfo<T>().name; });
     }
     else if constexpr (IsClass<T>::value)
     {
-        out << "class " << classInfo<T>().name;
+        return FixedString("class ") + toFixedString([] { return classInfo<T>().name; });
+    }
+    else
+    {
+        return FixedString("");
     }
 }
+} // namespace internal
+
+// type name of T (e.g. for error messages), built at compile time
+template <typename T> constexpr auto typeNameString = internal::buildTypeName<T>();
 
-template <typename T> [[nodiscard]] std::string buildTypeName()
+template <typename T> [[nodiscard]] constexpr std::string_view typeName()
 {
-    std::ostringstream out;
-    internal::buildTypeName<T>(out);
-    return out.str();
+    return typeNameString<T>.view();
 }
-} // namespace internal
 
-template <typename T> [[nodiscard]] std::string_view typeName()
+// a class with reflection information (i.e. classInfo<T>() has been specialized with REFLECT_IMPL_STRUCT_BEGIN)
+// note that this instantiates classInfo<T>(), so it should not be checked before the specialization
+template <typename T>
+concept Reflected = IsClass<T>::value && !std::is_void_v<decltype(classInfo<T>())>;
+
+// field-wise equality of reflected classes, only the reflected fields are compared (including REFLECT_MUTABLE fields)
+// containers and variants of reflected classes use this through their own operator==
+// classes with their own operator== member keep using that (it is checked first, because such a member can compare
+// the class before it is reflected)
+template <typename T>
+    requires(!requires(T const &value) { value.operator==(value); }) && Reflected<T>
+[[nodiscard]] bool operator==(T const &lhs, T const &rhs)
 {
-    static std::string typeName = internal::buildTypeName<T>();
-    return typeName;
+    return std::apply([&](auto const &...fields) { return ((lhs.*fields.value == rhs.*fields.value) && ...); },
+                      classInfo<T>().fields);
 }
 } // namespace xrit_unreal
 
@@ -4,35 +4,79 @@
 #include "../guid.h"
 #include "reflect.h"
 
-#include <sstream>
+#include <functional>
+#include <string>
+#include <string_view>
 
 namespace xrit_unreal
 {
+// appends json to a contiguous buffer, either a string owned by the writer, or a string provided by the caller (e.g. to
+// reuse its capacity, or to write directly after a message header)
+// separators are written before each entry except the first, so nothing that was written has to be removed again
+class JsonWriter
+{
+public:
+    // writes into a string owned by the writer, see take()
+    JsonWriter();
+
+    // appends to buffer, which should outlive the writer
+    explicit JsonWriter(std::string &buffer);
+
+    // the writer points into itself when it owns the buffer
+    JsonWriter(JsonWriter const &) = delete;
+    JsonWriter &operator=(JsonWriter const &) = delete;
+
+    void append(char character);
+    void append(std::string_view string);
+
+    // formatted with std::to_chars (locale independent), floats with the shortest representation that parses back to
+    // the same float
+    void appendNumber(int64_t value);
+    void appendNumber(uint64_t value);
+    void appendNumber(float value);
+
+    // appends the string between quotes, escaped as json string (RFC 8259): quotation marks, backslashes and control
+    // characters are escaped, all other bytes (including utf-8 sequences) are copied as is
+    void appendString(std::string_view string);
+
+    [[nodiscard]] std::string_view view() const;
+
+    // the buffer that is written to
+    [[nodiscard]] std::string &buffer();
+
+    // moves the buffer out of the writer, the writer should not be used afterwards
+    [[nodiscard]] std::string take() &&;
+
+private:
+    std::string owned;
+    std::string *out;
+};
+
 // built-in types (declarations only)
 
 // monostate (for std::variant)
-void serialize(std::monostate &, std::stringstream &out);
+void serialize(std::monostate const &, JsonWriter &out);
 
 // bool
-void serialize(bool &value, std::stringstream &out);
+void serialize(bool const &value, JsonWriter &out);
 
 // float
-void serialize(float &value, std::stringstream &out);
+void serialize(float const &value, JsonWriter &out);
 
 // int64_t
-void serialize(int64_t &value, std::stringstream &out);
+void serialize(int64_t const &value, JsonWriter &out);
 
 // uint64_t
-void serialize(uint64_t &value, std::stringstream &out);
+void serialize(uint64_t const &value, JsonWriter &out);
 
 // std::string_view
-void serialize(std::string_view &value, std::stringstream &out);
+void serialize(std::string_view const &value, JsonWriter &out);
 
 // guid
-void serialize(Guid &value, std::stringstream &out);
+void serialize(Guid const &value, JsonWriter &out);
 
 // serialize default (disabled)
-template <typename T> std::enable_if_t<IsDefault<T>::value, void> serialize(T &, std::stringstream &)
+template <typename T> std::enable_if_t<IsDefault<T>::value, void> serialize(T const &, JsonWriter &)
 {
     // static_assert(!sizeof(T)) makes sure the failure only happens when the template is instantiated, rather than
     // always
@@ -40,115 +84,306 @@ template <typename T> std::enable_if_t<IsDefault<T>::value, void> serialize(T &,
 }
 
 // serialize enum
-template <typename T> std::enable_if_t<std::is_enum_v<T>, void> serialize(T &value, std::stringstream &out)
+template <typename T> std::enable_if_t<std::is_enum_v<T>, void> serialize(T const &value, JsonWriter &out)
 {
-    out << "\"" << serializeEnum(value) << "\"";
+    out.append('"');
+    out.append(serializeEnum(value));
+    out.append('"');
 }
 
 // serialize vector
-template <typename T> std::enable_if_t<IsVector<T>::value, void> serialize(T &value, std::stringstream &out)
+template <typename T> std::enable_if_t<IsVector<T>::value, void> serialize(T const &value, JsonWriter &out)
 {
-    out << "[";
+    out.append('[');
     // iterate over all entries in the vector
     for (size_t i = 0; i < value.size(); i++)
     {
+        if (i > 0)
+        {
+            out.append(',');
+        }
         serialize(value[i], out);
-        if (i < value.size() - 1)
+    }
+    out.append(']');
+}
+
+// a range that is serialized as json array, each element is passed through projection before it is serialized.
+// used as field of a reflected view, so that values that are stored in another container (e.g. the values of a map)
+// can be serialized without copying them into a vector first. the range should outlive the view
+template <typename Range, typename Projection = std::identity> struct SerializedRange
+{
+    Range const &range;
+    Projection projection{};
+};
+
+// serialize range
+template <typename Range, typename Projection>
+void serialize(SerializedRange<Range, Projection> const &value, JsonWriter &out)
+{
+    out.append('[');
+    bool first = true;
+    for (auto const &element : value.range)
+    {
+        if (!first)
         {
-            out << ",";
+            out.append(',');
         }
+        first = false;
+        serialize(std::invoke(value.projection, element), out);
     }
-    out << "]";
+    out.append(']');
 }
 
 // serialize unordered map
-template <typename T> std::enable_if_t<IsUnorderedMap<T>::value, void> serialize(T &value, std::stringstream &out)
+template <typename T> std::enable_if_t<IsUnorderedMap<T>::value, void> serialize(T const &value, JsonWriter &out)
 {
     using KeyType = typename T::key_type;
     using MappedType = typename T::mapped_type;
 
-    out << "{";
-    for (std::pair<KeyType const, MappedType> &entry : value)
+    out.append('{');
+    bool first = true;
+    for (std::pair<KeyType const, MappedType> const &entry : value)
     {
-        KeyType key = entry.first;
-        MappedType &entryValue = entry.second;
-
-        // key should always be converted to a string
-        out << "\"";
-        serialize(key, out);
-        out << "\":";
-        serialize(entryValue, out);
-        out << ",";
-    }
-    if (!value.empty())
-    {
-        out.seekp(-1, std::stringstream::cur); // move back one place to get rid of the trailing comma
+        if (!first)
+        {
+            out.append(',');
+        }
+        first = false;
+
+        // key should always be converted to a string, strings, guids and enums already are
+        if constexpr (std::is_arithmetic_v<KeyType>)
+        {
+            out.append('"');
+            serialize(entry.first, out);
+            out.append('"');
+        }
+        else
+        {
+            serialize(entry.first, out);
+        }
+        out.append(':');
+        serialize(entry.second, out);
     }
-    out << "}";
+    out.append('}');
 }
 
 // forward declarations for serialize class
-template <typename T> void serializeClassFields(T &value, std::stringstream &out);
+template <typename T> void serializeClassFields(T const &value, JsonWriter &out);
 
 // serialize variant
-template <typename T> std::enable_if_t<IsVariant<T>::value, void> serialize(T &value, std::stringstream &out)
+template <typename T> std::enable_if_t<IsVariant<T>::value, void> serialize(T const &value, JsonWriter &out)
 {
     if (std::holds_alternative<std::monostate>(value))
     {
-        out << "{}";
+        out.append("{}");
         return;
     }
 
+    // the $type is the name stored in the same table that is used for parsing the variant
+    constexpr auto &lookup = variantTypeLookup<T>;
+    size_t index = value.index() - 1; // without monostate
     auto trySerialize = [&]<std::size_t Index>() {
+        if (index != Index)
+        {
+            return false;
+        }
         using Type = std::variant_alternative_t<Index + 1, T>;
-        if (std::holds_alternative<Type>(value))
+        out.append(R"({"$type":")");
+        out.append(lookup.keys[Index]);
+        out.append('"');
+        if constexpr (std::tuple_size_v<decltype(classInfo<Type>().fields)> > 0)
         {
-            auto struct_ = classInfo<Type>();
-            out << R"({"$type":")" << struct_.name << "\"";
-            if constexpr (std::tuple_size_v<decltype(struct_.fields)> > 0)
-            {
-                out << ",";
-                serializeClassFields(std::get<Type>(value), out);
-            }
-            out << "}";
+            out.append(',');
+            serializeClassFields(*std::get_if<Index + 1>(&value), out);
         }
+        out.append('}');
+        return true;
     };
 
-    auto iterateIndices = [&]<std::size_t... Indices>(std::index_sequence<Indices...>) {
-        (trySerialize.template operator()<Indices>(), ...);
-    };
-    constexpr size_t size = std::variant_size_v<T>;
-    iterateIndices(std::make_index_sequence<size - 1>{});
+    [&]<std::size_t... Indices>(std::index_sequence<Indices...>) {
+        (trySerialize.template operator()<Indices>() || ...);
+    }(std::make_index_sequence<std::variant_size_v<T> - 1>{});
 }
 
 // serialize class
-template <typename T> std::enable_if_t<IsClass<T>::value, void> serialize(T &value, std::stringstream &out)
+template <typename T> std::enable_if_t<IsClass<T>::value, void> serialize(T const &value, JsonWriter &out)
 {
-    out << "{";
+    out.append('{');
     serializeClassFields(value, out);
-    out << "}";
+    out.append('}');
+}
+
+namespace internal
+{
+template <typename T, size_t Index> [[nodiscard]] constexpr auto buildFieldPrefix()
+{
+    constexpr auto key = toFixedString([] { return std::get<Index>(classInfo<T>().fields).key; });
+    if constexpr (Index == 0)
+    {
+        return FixedString("\"") + key + FixedString("\":");
+    }
+    else
+    {
+        return FixedString(",\"") + key + FixedString("\":");
+    }
 }
 
+// `"key":` of the field at Index of T, preceded by the comma that separates it from the previous field, so that each
+// field is written with a single append
+template <typename T, size_t Index> constexpr auto fieldPrefix = buildFieldPrefix<T, Index>();
+} // namespace internal
+
 // serialize class fields implementation
-template <typename T> void serializeClassFields(T &value, std::stringstream &out)
+template <typename T> void serializeClassFields(T const &value, JsonWriter &out)
 {
     // iterate over all reflected fields in struct
-    int count = 0;
-    auto a = [&](auto &&...args) {
-        (([&]() {
-             out << "\"" << args.key << "\":";
-             serialize(value.*args.value, out);
-             out << ",";
-             count++;
-         }()),
-         ...);
-    };
-    std::apply(a, classInfo<T>().fields);
-    if (count > 0)
+    [&]<size_t... Indices>(std::index_sequence<Indices...>) {
+        (
+            [&] {
+                out.append(internal::fieldPrefix<T, Indices>.view());
+                serialize(value.*std::get<Indices>(classInfo<T>().fields).value, out);
+            }(),
+            ...);
+    }(std::make_index_sequence<std::tuple_size_v<decltype(classInfo<T>().fields)>>{});
+}
+
+// the size in bytes of the json that serialize() writes for a value, including escaped characters and the widths of
+// numbers. It follows the same traversal without writing anything, so that the output can be allocated exactly once,
+// e.g. as payloadCapacity of NodeMessageBuilder
+
+// built-in types (declarations only)
+
+// monostate (for std::variant)
+[[nodiscard]] size_t serializedSize(std::monostate const &);
+
+// bool
+[[nodiscard]] size_t serializedSize(bool const &value);
+
+// float
+[[nodiscard]] size_t serializedSize(float const &value);
+
+// int64_t
+[[nodiscard]] size_t serializedSize(int64_t const &value);
+
+// uint64_t
+[[nodiscard]] size_t serializedSize(uint64_t const &value);
+
+// std::string_view
+[[nodiscard]] size_t serializedSize(std::string_view const &value);
+
+// guid
+[[nodiscard]] size_t serializedSize(Guid const &value);
+
+// serialized size default (disabled)
+template <typename T> [[nodiscard]] std::enable_if_t<IsDefault<T>::value, size_t> serializedSize(T const &)
+{
+    static_assert(!sizeof(T), "serializedSize() not implemented for type");
+    return 0;
+}
+
+// serialized size enum
+template <typename T> [[nodiscard]] std::enable_if_t<std::is_enum_v<T>, size_t> serializedSize(T const &value)
+{
+    return 2 + serializeEnum(value).size();
+}
+
+// serialized size vector
+template <typename T> [[nodiscard]] std::enable_if_t<IsVector<T>::value, size_t> serializedSize(T const &value)
+{
+    size_t size = 2 + (value.empty() ? 0 : value.size() - 1); // brackets and commas
+    for (auto const &entry : value)
+    {
+        size += serializedSize(entry);
+    }
+    return size;
+}
+
+// serialized size range
+template <typename Range, typename Projection>
+[[nodiscard]] size_t serializedSize(SerializedRange<Range, Projection> const &value)
+{
+    size_t size = 2;
+    size_t count = 0;
+    for (auto const &element : value.range)
+    {
+        size += serializedSize(std::invoke(value.projection, element));
+        count++;
+    }
+    return size + (count == 0 ? 0 : count - 1);
+}
+
+// serialized size unordered map
+template <typename T> [[nodiscard]] std::enable_if_t<IsUnorderedMap<T>::value, size_t> serializedSize(T const &value)
+{
+    size_t size = 2 + (value.empty() ? 0 : value.size() - 1); // braces and commas
+    for (auto const &entry : value)
     {
-        out.seekp(-1, std::stringstream::cur); // move back one place to get rid of the trailing comma
+        size += serializedSize(entry.first) + 1 + serializedSize(entry.second); // key, colon and value
+        if constexpr (std::is_arithmetic_v<typename T::key_type>)
+        {
+            size += 2; // quotes around the key
+        }
     }
+    return size;
+}
+
+// forward declarations for serialized size class
+template <typename T> [[nodiscard]] size_t serializedClassFieldsSize(T const &value);
+
+// serialized size variant
+template <typename T> [[nodiscard]] std::enable_if_t<IsVariant<T>::value, size_t> serializedSize(T const &value)
+{
+    if (std::holds_alternative<std::monostate>(value))
+    {
+        return 2;
+    }
+
+    constexpr auto &lookup = variantTypeLookup<T>;
+    size_t index = value.index() - 1; // without monostate
+    size_t size = 0;
+    auto trySize = [&]<std::size_t Index>() {
+        if (index != Index)
+        {
+            return false;
+        }
+        using Type = std::variant_alternative_t<Index + 1, T>;
+        size = std::string_view(R"({"$type":"")").size() + lookup.keys[Index].size() + 1; // `{"$type":"name"}`
+        if constexpr (std::tuple_size_v<decltype(classInfo<Type>().fields)> > 0)
+        {
+            size += 1 + serializedClassFieldsSize(*std::get_if<Index + 1>(&value));
+        }
+        return true;
+    };
+
+    [&]<std::size_t... Indices>(std::index_sequence<Indices...>) {
+        (trySize.template operator()<Indices>() || ...);
+    }(std::make_index_sequence<std::variant_size_v<T> - 1>{});
+    return size;
+}
+
+// serialized size class
+template <typename T> [[nodiscard]] std::enable_if_t<IsClass<T>::value, size_t> serializedSize(T const &value)
+{
+    return 2 + serializedClassFieldsSize(value);
+}
+
+// serialized size class fields implementation
+template <typename T> size_t serializedClassFieldsSize(T const &value)
+{
+    return [&]<size_t... Indices>(std::index_sequence<Indices...>) {
+        return (size_t(0) + ... +
+                (internal::fieldPrefix<T, Indices>.view().size() +
+                 serializedSize(value.*std::get<Indices>(classInfo<T>().fields).value)));
+    }(std::make_index_sequence<std::tuple_size_v<decltype(classInfo<T>().fields)>>{});
+}
+
+// serializes the value into a new string
+template <typename T> [[nodiscard]] std::string serializeToString(T const &value)
+{
+    JsonWriter out;
+    serialize(value, out);
+    return std::move(out).take();
 }
 } // namespace xrit_unreal
 
-#endif // XRIT_UNREAL_SERIALIZE_H
\ No newline at end of file
+#endif // XRIT_UNREAL_SERIALIZE_H
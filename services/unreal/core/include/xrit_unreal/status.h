@@ -0,0 +1,51 @@
+#ifndef XRIT_UNREAL_STATUS_H
+#define XRIT_UNREAL_STATUS_H
+
+#include "data/configuration.h"
+#include "livelink.h"
+#include "reflect/reflect.h"
+#include "reflect/serialize.h"
+
+#include <unordered_map>
+
+namespace xrit_unreal
+{
+// the source of a cache entry
+struct LiveLinkSourceCacheEntryValue
+{
+    [[nodiscard]] LiveLinkSourceVariants const &operator()(
+        std::pair<Guid const, LiveLinkSourceCacheEntry> const &entry) const
+    {
+        return entry.second.value;
+    }
+};
+
+// the sources of the cache, serialized as json array of sources
+using LiveLinkSourceCacheView =
+    SerializedRange<std::unordered_map<Guid, LiveLinkSourceCacheEntry>, LiveLinkSourceCacheEntryValue>;
+
+// the status that is sent to the node, as a view of the sources in the cache. It serializes to the same json as a
+// Configuration that contains copies of the sources, but without copying them
+//
+// usage:
+// StatusView status{.livelink{.sources{cache.entries}}};
+// serialize(status, out);
+REFLECT_STRUCT
+
+struct LiveLinkStatusView
+{
+    LiveLinkSourceCacheView REFLECT(sources);
+};
+
+REFLECT_STRUCT
+
+struct StatusView
+{
+    Ip REFLECT(udp_unicast_endpoint);
+    LiveLinkStatusView REFLECT(livelink);
+};
+} // namespace xrit_unreal
+
+#include "status_generated.h"
+
+#endif // XRIT_UNREAL_STATUS_H
@@ -0,0 +1,14 @@
+// -----------------------------------------------------------
+// automatically generated with scripts/generate_reflection.py
+// don't edit this file directly.
+// -----------------------------------------------------------
+
+REFLECT_IMPL_STRUCT_BEGIN(xrit_unreal::LiveLinkStatusView)
+    REFLECT_IMPL_FIELD(sources)
+REFLECT_IMPL_STRUCT_END
+
+REFLECT_IMPL_STRUCT_BEGIN(xrit_unreal::StatusView)
+    REFLECT_IMPL_FIELD(udp_unicast_endpoint)
+    REFLECT_IMPL_FIELD(livelink)
+REFLECT_IMPL_STRUCT_END
+
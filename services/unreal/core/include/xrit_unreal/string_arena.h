@@ -0,0 +1,43 @@
+#ifndef XRIT_UNREAL_STRING_ARENA_H
+#define XRIT_UNREAL_STRING_ARENA_H
+
+#include <forward_list>
+#include <memory>
+#include <string_view>
+
+namespace xrit_unreal
+{
+// owns copies of strings in one contiguous block, so that values parsed from json can reference their strings after
+// the json is destroyed (e.g. to move a parsed configuration to another thread)
+// the strings of a json document are never longer than the document itself, so with the length of the json as
+// capacity all of its strings fit in the one block. strings that don't fit get a block of their own.
+// stored strings keep their address when the arena is moved
+class StringArena
+{
+public:
+    explicit StringArena(size_t capacity);
+
+    StringArena(StringArena const &) = delete;
+    StringArena &operator=(StringArena const &) = delete;
+    StringArena(StringArena &&) noexcept = default;
+    StringArena &operator=(StringArena &&) noexcept = default;
+
+    // copies the string into the arena, and returns a view of the copy
+    [[nodiscard]] std::string_view store(std::string_view string);
+
+    // total length of the stored strings
+    [[nodiscard]] size_t size() const;
+
+    // size of the contiguous block
+    [[nodiscard]] size_t capacity() const;
+
+private:
+    std::unique_ptr<char[]> block;
+    size_t blockCapacity;
+    size_t blockSize = 0;
+    size_t storedSize = 0;
+    std::forward_list<std::unique_ptr<char[]>> overflowBlocks;
+};
+} // namespace xrit_unreal
+
+#endif // XRIT_UNREAL_STRING_ARENA_H
@@ -1,6 +1,8 @@
 #ifndef XRIT_UNREAL_WEBSOCKET_H
 #define XRIT_UNREAL_WEBSOCKET_H
 
+#include <simdjson.h>
+
 #include <memory>
 #include <queue>
 #include <string>
@@ -15,7 +17,9 @@ struct IWebSocketListener
 
     virtual void onConnected(WebSocket *caller) = 0;
 
-    virtual void onMessage(WebSocket *caller, std::string message) = 0;
+    // message is only valid during the call, and is followed by simdjson::SIMDJSON_PADDING bytes, so that it (and
+    // sub views up to its end) can be parsed by simdjson without copying
+    virtual void onMessage(WebSocket *caller, simdjson::padded_string_view message) = 0;
 };
 
 struct WebSocketConfiguration
@@ -45,6 +49,9 @@ class WebSocket
 
     void sendMessage(std::string const &message) const;
 
+    // moves the message into the outbound queue without copying
+    void sendMessage(std::string &&message) const;
+
     // call like this:
     // while (webSocket.poll() == WebSocketStatus::Success) {}
     [[nodiscard]] WebSocketStatus poll() const;
@@ -216,15 +216,17 @@ def get_structs(string, namespaceRanges):
         fieldsIndex = fieldsStartIndex
         fields = []
         while True:
-            fieldNameStartIndex = string.find("REFLECT(", fieldsIndex, fieldsEndIndex)
-            if fieldNameStartIndex == -1:
+            # fields are marked with REFLECT(name), or REFLECT_MUTABLE(name) if they can be changed at runtime
+            match = re.compile(r'REFLECT(_MUTABLE)?\(').search(string, fieldsIndex, fieldsEndIndex)
+            if match is None:
                 break
-            fieldNameStartIndex += len("REFLECT(")
+            fieldNameStartIndex = match.end()
             fieldNameStopIndex = string.find(')', fieldNameStartIndex)
             assert fieldNameStopIndex != -1
 
             fieldName = string[fieldNameStartIndex:fieldNameStopIndex]
-            fields.append(fieldName)
+            isMutable = match.group(1) is not None
+            fields.append([fieldName, isMutable])
 
             fieldsIndex = fieldNameStopIndex
 
@@ -291,7 +293,12 @@ def generate_struct_reflection(structs):
         output += "REFLECT_IMPL_STRUCT_BEGIN(" + structName + ")\n"
 
         for field in fields:
-            output += "    REFLECT_IMPL_FIELD(" + field + ")\n"
+            fieldName = field[0]
+            isMutable = field[1]
+            if isMutable:
+                output += "    REFLECT_IMPL_MUTABLE_FIELD(" + fieldName + ")\n"
+            else:
+                output += "    REFLECT_IMPL_FIELD(" + fieldName + ")\n"
 
         output += "REFLECT_IMPL_STRUCT_END\n\n"
 
@@ -1,11 +1,16 @@
 #include "communication_protocol.h"
 
+#include "parse_json.h"
+#include "reflect/parse.h"
+#include "reflect/serialize.h"
+
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 
 namespace xrit_unreal
 {
-bool getMessageData(std::string_view message, MessageData *outMessage)
+bool getMessageData(simdjson::padded_string_view message, MessageData *outMessage)
 {
     size_t const commandIndex = message.find_first_of(':', 0);
     if (commandIndex == std::string::npos)
@@ -21,13 +26,14 @@ bool getMessageData(std::string_view message, MessageData *outMessage)
     {
         // valid, but we don't have data, only command
         outMessage->command = message.substr(commandIndex + 1, message.size() - 1);
-        outMessage->data = std::string_view();
+        outMessage->data = simdjson::padded_string_view(message.substr(message.size()), message.padding());
     }
     else
     {
-        // valid data found
+        // valid data found, the data is the end of the message, so the padding after the message stays available
         outMessage->command = message.substr(commandIndex + 1, dataIndex - commandIndex - 1);
-        outMessage->data = message.substr(dataIndex + 1, message.size() - dataIndex - 1);
+        std::string_view data = message.substr(dataIndex + 1, message.size() - dataIndex - 1);
+        outMessage->data = simdjson::padded_string_view(data, data.size() + message.padding());
     }
 
     return true;
@@ -63,20 +69,40 @@ bool getNodeMessage(MessageData const &message, NodeMessageData &outMessage)
 
 // create message for the node
 std::string createNodeMessage(NodeCommand nodeCommand, std::string_view data)
+{
+    NodeMessageBuilder builder(nodeCommand, data.size());
+    builder.payload().append(data);
+    return std::move(builder).finish();
+}
+
+NodeMessageBuilder::NodeMessageBuilder(NodeCommand nodeCommand, size_t payloadCapacity)
 {
     assert(nodeCommand < NodeCommand::Count && nodeCommand != NodeCommand::Invalid);
 
-    std::string result;
-    result += serializeEnum(Channel::unreal_to_node);
-    result += ":";
-    result += serializeEnum(nodeCommand);
+    std::string_view channel = serializeEnum(Channel::unreal_to_node);
+    std::string_view command = serializeEnum(nodeCommand);
+    headerSize = channel.size() + 1 + command.size() + 1;
 
-    if (!data.empty())
+    message.reserve(headerSize + payloadCapacity);
+    message += channel;
+    message += ":";
+    message += command;
+    message += "\n";
+}
+
+JsonWriter &NodeMessageBuilder::payload()
+{
+    return out;
+}
+
+std::string NodeMessageBuilder::finish() &&
+{
+    if (message.size() == headerSize)
     {
-        result += "\n";
-        result += data;
+        // a message without data does not need a \n
+        message.pop_back();
     }
-    return result;
+    return std::move(message);
 }
 
 // create message for unreal
@@ -96,4 +122,81 @@ std::string createMockUnrealMessage(UnrealCommand unrealCommand, std::string_vie
     }
     return result;
 }
+
+Capabilities supportedCapabilities()
+{
+    // none of the optional features are implemented yet, so we always communicate using the plain text protocol
+    return Capabilities{};
+}
+
+Capabilities negotiateCapabilities(Capabilities const &local, Capabilities const &remote)
+{
+    uint64_t heartbeatIntervalMs = 0;
+    if (local.heartbeat_interval_ms != 0 && remote.heartbeat_interval_ms != 0)
+    {
+        // the side with the largest interval determines how often we can send heartbeats
+        heartbeatIntervalMs = std::max(local.heartbeat_interval_ms, remote.heartbeat_interval_ms);
+    }
+
+    return Capabilities{.compression = local.compression && remote.compression,
+                        .binary_envelope = local.binary_envelope && remote.binary_envelope,
+                        .delta_status = local.delta_status && remote.delta_status,
+                        .batching = local.batching && remote.batching,
+                        .heartbeat_interval_ms = heartbeatIntervalMs};
+}
+
+// parses the capabilities from the (non empty) document
+static bool parseCapabilitiesDocument(PooledJsonDocument &document, Capabilities &outCapabilities)
+{
+    simdjson::ondemand::value value;
+    if (document.document.get_value().get(value) != simdjson::SUCCESS)
+    {
+        return false;
+    }
+
+    Capabilities capabilities{};
+    ParseErrors errors = parse(value, capabilities, "");
+    for (ParseError const &error : errors)
+    {
+        if (error.code != ParseErrorCode::InvalidField)
+        {
+            return false;
+        }
+    }
+    outCapabilities = capabilities;
+    return true;
+}
+
+bool parseCapabilities(std::string_view data, Capabilities &outCapabilities)
+{
+    if (data.empty())
+    {
+        // peer does not support capabilities
+        outCapabilities = Capabilities{};
+        return true;
+    }
+
+    PooledJsonDocument document;
+    return jsonParserPool().parse(data, document) == simdjson::SUCCESS &&
+           parseCapabilitiesDocument(document, outCapabilities);
+}
+
+bool parseCapabilities(simdjson::padded_string_view data, Capabilities &outCapabilities)
+{
+    if (data.empty())
+    {
+        // peer does not support capabilities
+        outCapabilities = Capabilities{};
+        return true;
+    }
+
+    PooledJsonDocument document;
+    return jsonParserPool().parse(data, document) == simdjson::SUCCESS &&
+           parseCapabilitiesDocument(document, outCapabilities);
+}
+
+std::string serializeCapabilities(Capabilities capabilities)
+{
+    return serializeToString(capabilities);
+}
 } // namespace xrit_unreal
\ No newline at end of file
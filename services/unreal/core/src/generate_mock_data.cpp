@@ -3,6 +3,7 @@
 #include <random>
 
 #include "data/configuration.h"
+#include "json_format.h"
 
 #include "reflect/serialize.h"
 
@@ -10,7 +11,6 @@ namespace xrit_unreal
 {
 std::string generateMockConfiguration()
 {
-    std::stringstream out;
     Configuration configuration{
         .udp_unicast_endpoint{.url = "192.168.0.1", .port = 1000},
         .livelink{.sources{
@@ -31,33 +31,75 @@ std::string generateMockConfiguration()
             LiveLinkFreeDSource{.id = generateMockGuid(),
                                 .settings{.ip_address = "192.168.0.1", .udp_port = 1234567}}}}};
 
-    serialize(configuration, out);
-    return prettifyJson(out.str());
+    return prettifyJson(serializeToString(configuration));
+}
+
+std::string generateLargeMockConfiguration(size_t sourceCount)
+{
+    Configuration configuration{.udp_unicast_endpoint{.url = "192.168.0.1", .port = 1000}};
+    configuration.livelink.sources.reserve(sourceCount);
+    for (size_t i = 0; i < sourceCount; i++)
+    {
+        // cycle through all source types
+        switch (i % 7)
+        {
+        case 0:
+            configuration.livelink.sources.emplace_back(LiveLinkDummySource{
+                .id = generateMockGuid(), .settings{.ip_address = "10.10.10.10", .port = static_cast<int64_t>(i)}});
+            break;
+        case 1:
+            configuration.livelink.sources.emplace_back(LiveLinkMvnSource{
+                .id = generateMockGuid(),
+                .settings{.port = static_cast<int64_t>(i), .base{.mode = LiveLinkSourceMode::Timecode}}});
+            break;
+        case 2:
+            configuration.livelink.sources.emplace_back(LiveLinkOptitrackSource{
+                .id = generateMockGuid(),
+                .settings{.server_address = "123.4.5.6", .client_address = "192.168.10.10", .is_multicast = true}});
+            break;
+        case 3:
+            configuration.livelink.sources.emplace_back(
+                LiveLinkXrSource{.id = generateMockGuid(), .settings{.track_hmds = true}, .subjects{1, 2, 3}});
+            break;
+        case 4:
+            configuration.livelink.sources.emplace_back(VirtualSubjectSource{.id = generateMockGuid()});
+            break;
+        case 5:
+            configuration.livelink.sources.emplace_back(LiveLinkFreeDSource{
+                .id = generateMockGuid(),
+                .settings{.ip_address = "192.168.0.1", .default_config = FreeDDefaultConfigs::Sony}});
+            break;
+        default:
+            configuration.livelink.sources.emplace_back(
+                LiveLinkMessageBusSource{.id = generateMockGuid(),
+                                         .settings{.source_type = "LiveLinkMessageBusSource",
+                                                   .machine_name = "machine",
+                                                   .address = generateMockGuid()}});
+            break;
+        }
+    }
+
+    return serializeToString(configuration);
 }
 
 std::string generateMockSetConfigurationResultSuccess()
 {
-    std::stringstream out;
     SetConfigurationResult result{};
-    serialize(result, out);
-    return prettifyJson(out.str());
+    return prettifyJson(serializeToString(result));
 }
 
 std::string generateMockSetConfigurationResultParseError()
 {
-    std::stringstream out;
     SetConfigurationResult result{.parse_errors{ParseError{.code = ParseErrorCode::InvalidValue,
-                                                           .containing_object = "object_name_here",
+                                                           .containing_object = "/livelink/sources/0",
                                                            .value = "1234",
                                                            .message = "Guid does not contain valid value"}}};
-    serialize(result, out);
-    return prettifyJson(out.str());
+    return prettifyJson(serializeToString(result));
 }
 
 std::string generateMockStatus()
 {
-    std::stringstream out;
-    return out.str();
+    return {};
 }
 
 Guid generateMockGuid()
@@ -69,99 +111,4 @@ Guid generateMockGuid()
     Guid out{.a = dist(gen), .b = dist(gen), .c = dist(gen), .d = dist(gen)};
     return out;
 }
-
-void indent(uint32_t indentation, char character, uint32_t count, std::stringstream &out)
-{
-    for (size_t i = 0; i < indentation * count; i++)
-    {
-        out << character;
-    }
-}
-
-std::string prettifyJson(std::string_view json, uint32_t indentationCount, char indentationCharacter)
-{
-    std::stringstream out;
-    uint32_t indentation = 0;
-
-    size_t index = 0;
-    size_t length = json.size();
-    while (index < length)
-    {
-        char const *current = json.data() + index;
-
-        // skip whitespace
-        if (current[0] == ' ' || current[0] == '\t' || current[0] == '\n')
-        {
-            ++index;
-            continue;
-        }
-
-        // string
-        if (current[0] == '"')
-        {
-            char const *end = current + 1;
-            // find the next " that isn't preceded by an escape literal
-            while (true)
-            {
-                end = strchr(end, '"');
-                assert(end != nullptr && "unclosed string literal");
-
-                if (*(end - 1) == '\\')
-                {
-                    ++end; // skip the "
-                }
-                else
-                {
-                    break;
-                }
-            }
-            size_t stringLength = end - current + 1;
-            std::string_view literal(current, stringLength);
-            out << literal;
-            index += stringLength;
-            continue;
-        }
-
-        // open scope
-        if (current[0] == '{' || current[0] == '[')
-        {
-            out << current[0] << '\n';
-            ++indentation;
-            indent(indentation, indentationCharacter, indentationCount, out);
-            ++index;
-            continue;
-        }
-
-        // close scope
-        if (current[0] == '}' || current[0] == ']')
-        {
-            out << '\n';
-            --indentation;
-            indent(indentation, indentationCharacter, indentationCount, out);
-            out << current[0];
-            ++index;
-            continue;
-        }
-
-        if (current[0] == ',')
-        {
-            out << current[0] << '\n';
-            indent(indentation, indentationCharacter, indentationCount, out);
-            ++index;
-            continue;
-        }
-
-        if (current[0] == ':')
-        {
-            out << current[0] << ' ';
-            ++index;
-            continue;
-        }
-
-        out << current[0];
-        ++index;
-    }
-
-    return out.str();
-}
 } // namespace xrit_unreal
\ No newline at end of file
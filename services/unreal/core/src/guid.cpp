@@ -1,7 +1,17 @@
 #include "guid.h"
 
-#include <iomanip>
-#include <sstream>
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <string>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define XRIT_UNREAL_GUID_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define XRIT_UNREAL_GUID_NEON
+#endif
 
 namespace xrit_unreal
 {
@@ -15,29 +25,47 @@ bool operator!=(Guid const &lhs, Guid const &rhs)
     return !(lhs == rhs);
 }
 
-bool isHexCharacter(char character)
-{
-    return isxdigit(character);
-}
-
-uint32_t parseHexCharacter(char c)
-{
-    if (c >= '0' && c <= '9')
+// value of each hex character, and invalidHex for all other characters
+constexpr uint8_t invalidHex = 0xFF;
+static constexpr std::array<uint8_t, 256> hexValues = []() {
+    std::array<uint8_t, 256> values{};
+    values.fill(invalidHex);
+    for (uint8_t i = 0; i < 10; i++)
     {
-        return c - '0';
+        values['0' + i] = i;
     }
-    else if (c >= 'a' && c <= 'f')
+    for (uint8_t i = 0; i < 6; i++)
     {
-        return c + 10 - 'a';
+        values['a' + i] = 10 + i;
+        values['A' + i] = 10 + i;
     }
-    else if (c >= 'A' && c <= 'F')
-    {
-        return c + 10 - 'A';
-    }
-    else
+    return values;
+}();
+
+// the two lowercase hex characters of each byte
+static constexpr std::array<std::array<char, 2>, 256> hexPairs = []() {
+    constexpr char digits[] = "0123456789abcdef";
+    std::array<std::array<char, 2>, 256> pairs{};
+    for (size_t i = 0; i < 256; i++)
     {
-        return 0;
+        pairs[i] = {digits[i >> 4], digits[i & 0xF]};
     }
+    return pairs;
+}();
+
+// position in the guid string of the first hex character of each byte, the bytes are in the order of a, b, c and d,
+// from the most to the least significant byte
+static constexpr std::array<uint8_t, 16> bytePositions{0, 2, 4, 6, 9, 11, 14, 16, 19, 21, 24, 26, 28, 30, 32, 34};
+
+bool isHexCharacter(char character)
+{
+    return hexValues[static_cast<uint8_t>(character)] != invalidHex;
+}
+
+uint32_t parseHexCharacter(char c)
+{
+    uint8_t value = hexValues[static_cast<uint8_t>(c)];
+    return value == invalidHex ? 0 : value;
 }
 
 uint32_t parseHexNumber32Bits(std::string_view string)
@@ -57,69 +85,180 @@ uint32_t parseHexNumber32Bits(std::string_view string)
     return result;
 }
 
-std::vector<ParseError> parseGuid(std::string_view value, Guid &outGuid, std::string_view fieldName)
+/*
+The 32 hex characters of a guid string are gathered into two vectors of 16 characters without the hyphens, such that
+each pair of characters that forms a byte starts at an even position. Unaligned loads at different offsets put each
+group of characters at the right position, and the groups are selected with masks:
+
+    first:  0-7 from offset 0, 9-12 from offset 1, 14-17 from offset 2
+    second: 19-22 from offset 19, 24-35 from offset 20
+*/
+#if defined(XRIT_UNREAL_GUID_SSE2)
+// converts 16 hex characters to their values, and sets invalid to all ones in the lanes of the other characters
+static __m128i hexValues16(__m128i bytes, __m128i &invalid)
+{
+    // signed comparisons, so bytes >= 0x80 are below every range
+    auto inRange = [](__m128i bytes, char first, char last) {
+        return _mm_and_si128(_mm_cmpgt_epi8(bytes, _mm_set1_epi8(static_cast<char>(first - 1))),
+                             _mm_cmpgt_epi8(_mm_set1_epi8(static_cast<char>(last + 1)), bytes));
+    };
+    __m128i lowered = _mm_or_si128(bytes, _mm_set1_epi8(0x20)); // 'A' to 'F' become 'a' to 'f'
+    __m128i digit = inRange(bytes, '0', '9');
+    __m128i letter = inRange(lowered, 'a', 'f');
+    invalid = _mm_or_si128(invalid, _mm_andnot_si128(_mm_or_si128(digit, letter), _mm_set1_epi8(-1)));
+    return _mm_or_si128(_mm_and_si128(digit, _mm_sub_epi8(bytes, _mm_set1_epi8('0'))),
+                        _mm_and_si128(letter, _mm_sub_epi8(lowered, _mm_set1_epi8('a' - 10))));
+}
+
+// each pair of values (high nibble first) to a byte, in the low byte of each 16 bit lane
+static __m128i combineNibbles(__m128i nibbles)
+{
+    return _mm_or_si128(_mm_slli_epi16(_mm_and_si128(nibbles, _mm_set1_epi16(0x00FF)), 4),
+                        _mm_srli_epi16(nibbles, 8));
+}
+
+// parses the 36 characters of a guid string of which the hyphens have been checked, returns false if any of the other
+// characters is not a hex character
+static bool parseHexCharacters(char const *characters, Guid &out)
 {
-    if (value.length() != 36)
+    auto load = [&](size_t offset) {
+        return _mm_loadu_si128(reinterpret_cast<__m128i const *>(characters + offset));
+    };
+    __m128i const firstOffset0 = _mm_setr_epi32(-1, -1, 0, 0);
+    __m128i const firstOffset1 = _mm_setr_epi32(0, 0, -1, 0);
+    __m128i const firstOffset2 = _mm_setr_epi32(0, 0, 0, -1);
+    __m128i const secondOffset19 = _mm_setr_epi32(-1, 0, 0, 0);
+    __m128i first = _mm_or_si128(_mm_and_si128(load(0), firstOffset0),
+                                 _mm_or_si128(_mm_and_si128(load(1), firstOffset1), _mm_and_si128(load(2), firstOffset2)));
+    __m128i second = _mm_or_si128(_mm_and_si128(load(19), secondOffset19), _mm_andnot_si128(secondOffset19, load(20)));
+
+    __m128i invalid = _mm_setzero_si128();
+    first = hexValues16(first, invalid);
+    second = hexValues16(second, invalid);
+    if (_mm_movemask_epi8(invalid) != 0)
     {
-        return {(ParseError{ParseErrorCode::InvalidValue, fieldName, value, "guid string should have length 36"})};
+        return false;
     }
-    if (value[8] != '-' || value[13] != '-' || value[18] != '-' || value[23] != '-')
+
+    // the bytes in string order, then each 32 bit word reversed to little endian
+    __m128i bytes = _mm_packus_epi16(combineNibbles(first), combineNibbles(second));
+    bytes = _mm_or_si128(_mm_slli_epi16(bytes, 8), _mm_srli_epi16(bytes, 8));
+    bytes = _mm_shufflehi_epi16(_mm_shufflelo_epi16(bytes, _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1));
+    std::memcpy(&out, &bytes, sizeof(Guid));
+    return true;
+}
+#elif defined(XRIT_UNREAL_GUID_NEON)
+// converts 16 hex characters to their values, and sets invalid to all ones in the lanes of the other characters
+static uint8x16_t hexValues16(uint8x16_t bytes, uint8x16_t &invalid)
+{
+    uint8x16_t lowered = vorrq_u8(bytes, vdupq_n_u8(0x20)); // 'A' to 'F' become 'a' to 'f'
+    uint8x16_t digitValues = vsubq_u8(bytes, vdupq_n_u8('0'));
+    uint8x16_t letterValues = vsubq_u8(lowered, vdupq_n_u8('a'));
+    uint8x16_t digit = vcltq_u8(digitValues, vdupq_n_u8(10));
+    uint8x16_t letter = vcltq_u8(letterValues, vdupq_n_u8(6));
+    invalid = vorrq_u8(invalid, vmvnq_u8(vorrq_u8(digit, letter)));
+    return vorrq_u8(vandq_u8(digit, digitValues), vandq_u8(letter, vaddq_u8(letterValues, vdupq_n_u8(10))));
+}
+
+// parses the 36 characters of a guid string of which the hyphens have been checked, returns false if any of the other
+// characters is not a hex character
+static bool parseHexCharacters(char const *characters, Guid &out)
+{
+    auto load = [&](size_t offset) { return vld1q_u8(reinterpret_cast<uint8_t const *>(characters + offset)); };
+    uint8x16_t const firstOffset0 = vreinterpretq_u8_u32(uint32x4_t{~uint32_t(0), ~uint32_t(0), 0, 0});
+    uint8x16_t const firstOffset1 = vreinterpretq_u8_u32(uint32x4_t{0, 0, ~uint32_t(0), 0});
+    uint8x16_t const secondOffset19 = vreinterpretq_u8_u32(uint32x4_t{~uint32_t(0), 0, 0, 0});
+    uint8x16_t first = vbslq_u8(firstOffset0, load(0), vbslq_u8(firstOffset1, load(1), load(2)));
+    uint8x16_t second = vbslq_u8(secondOffset19, load(19), load(20));
+
+    uint8x16_t invalid = vdupq_n_u8(0);
+    first = hexValues16(first, invalid);
+    second = hexValues16(second, invalid);
+    if (vmaxvq_u8(invalid) != 0)
+    {
+        return false;
+    }
+
+    // the high nibbles are at the even positions. The bytes in string order, then each 32 bit word reversed to little
+    // endian
+    uint8x16x2_t nibbles = vuzpq_u8(first, second);
+    uint8x16_t bytes = vrev32q_u8(vorrq_u8(vshlq_n_u8(nibbles.val[0], 4), nibbles.val[1]));
+    std::memcpy(&out, &bytes, sizeof(Guid));
+    return true;
+}
+#else
+// parses the 36 characters of a guid string of which the hyphens have been checked, returns false if any of the other
+// characters is not a hex character
+static bool parseHexCharacters(char const *characters, Guid &out)
+{
+    // all characters are looked up before checking whether any of them was invalid, so that there are no branches per
+    // character. invalidHex has the high bit set, which no valid value has
+    uint32_t words[4]{};
+    uint8_t invalid = 0;
+    for (size_t i = 0; i < bytePositions.size(); i++)
     {
-        return {(ParseError{ParseErrorCode::InvalidValue, fieldName, value,
-                            "guid hyphen placement is incorrect, expected: 00000000-0000-0000-0000-000000000000"})};
+        uint8_t high = hexValues[static_cast<uint8_t>(characters[bytePositions[i]])];
+        uint8_t low = hexValues[static_cast<uint8_t>(characters[bytePositions[i] + 1])];
+        invalid |= high | low;
+        words[i / 4] = (words[i / 4] << 8) | static_cast<uint32_t>((high << 4) | (low & 0xF));
     }
+    if ((invalid & 0x80) != 0)
+    {
+        return false;
+    }
+    out = {.a = words[0], .b = words[1], .c = words[2], .d = words[3]};
+    return true;
+}
+#endif
 
-    // create string without hyphens
-    std::string stringWithoutHyphens;
-    stringWithoutHyphens.reserve(32);
-    stringWithoutHyphens += value.substr(0, 8);
-    stringWithoutHyphens += value.substr(9, 4);
-    stringWithoutHyphens += value.substr(14, 4);
-    stringWithoutHyphens += value.substr(19, 4);
-    stringWithoutHyphens += value.substr(24, 12);
+std::string_view tryParseGuid(std::string_view value, Guid &outGuid)
+{
+    if (value.length() != guidStringLength)
+    {
+        return "guid string should have length 36";
+    }
+    if (value[8] != '-' || value[13] != '-' || value[18] != '-' || value[23] != '-')
+    {
+        return "guid hyphen placement is incorrect, expected: 00000000-0000-0000-0000-000000000000";
+    }
 
-    for (char character : stringWithoutHyphens)
+    Guid guid;
+    if (!parseHexCharacters(value.data(), guid))
     {
-        if (!isHexCharacter(character))
-        {
-            return {(ParseError{ParseErrorCode::InvalidValue, fieldName, value,
-                                "guid characters should be valid hex characters"})};
-        }
+        return "guid characters should be valid hex characters";
     }
+    outGuid = guid;
+    return {};
+}
 
-    outGuid = {.a = parseHexNumber32Bits(stringWithoutHyphens.substr(0, 8)),
-               .b = parseHexNumber32Bits(stringWithoutHyphens.substr(8, 8)),
-               .c = parseHexNumber32Bits(stringWithoutHyphens.substr(16, 8)),
-               .d = parseHexNumber32Bits(stringWithoutHyphens.substr(24, 8))};
+std::vector<ParseError> parseGuid(std::string_view value, Guid &outGuid, std::string_view fieldName)
+{
+    std::string_view errorMessage = tryParseGuid(value, outGuid);
+    if (!errorMessage.empty())
+    {
+        return {ParseError{ParseErrorCode::InvalidValue, fieldName, value, errorMessage}};
+    }
     return {};
 }
 
-void serializeInt32ToHex(uint32_t value, std::ostringstream &out)
+void formatGuid(Guid const &guid, char *out)
 {
-    out << std::setw(8) << std::setfill('0') << std::hex << value;
+    uint32_t const words[4]{guid.a, guid.b, guid.c, guid.d};
+    for (size_t i = 0; i < bytePositions.size(); i++)
+    {
+        uint8_t byte = static_cast<uint8_t>(words[i / 4] >> (24 - 8 * (i % 4)));
+        std::memcpy(out + bytePositions[i], hexPairs[byte].data(), 2);
+    }
+    out[8] = '-';
+    out[13] = '-';
+    out[18] = '-';
+    out[23] = '-';
 }
 
 std::string serializeGuid(Guid const &guid)
 {
-    std::ostringstream streamWithoutHyphens;
-    serializeInt32ToHex(guid.a, streamWithoutHyphens);
-    serializeInt32ToHex(guid.b, streamWithoutHyphens);
-    serializeInt32ToHex(guid.c, streamWithoutHyphens);
-    serializeInt32ToHex(guid.d, streamWithoutHyphens);
-
-    // hyphenate
-    std::string stringWithoutHyphens = streamWithoutHyphens.str();
-    std::string stringWithHyphens;
-    stringWithHyphens.reserve(36);
-    stringWithHyphens += stringWithoutHyphens.substr(0, 8);
-    stringWithHyphens += "-";
-    stringWithHyphens += stringWithoutHyphens.substr(8, 4);
-    stringWithHyphens += "-";
-    stringWithHyphens += stringWithoutHyphens.substr(12, 4);
-    stringWithHyphens += "-";
-    stringWithHyphens += stringWithoutHyphens.substr(16, 4);
-    stringWithHyphens += "-";
-    stringWithHyphens += stringWithoutHyphens.substr(20, 12);
-    return stringWithHyphens;
+    std::string string(guidStringLength, '\0');
+    formatGuid(guid, string.data());
+    return string;
 }
 } // namespace xrit_unreal
\ No newline at end of file
@@ -0,0 +1,306 @@
+#include "json_format.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define XRIT_UNREAL_JSON_FORMAT_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define XRIT_UNREAL_JSON_FORMAT_NEON
+#endif
+
+/*
+The json is scanned like in the first stage of simdjson: for each block of 64 bytes, bit masks of the quotes,
+backslashes, structural characters and whitespace are created (16 bytes per instruction when SSE2 or NEON is
+available). The quotes that are not escaped give a mask of the bytes inside strings, so the structural characters and
+whitespace outside of strings are found with a few bit operations per block. Only those characters are handled one
+by one, everything in between (strings, numbers and literals) is copied in bulk.
+*/
+
+namespace xrit_unreal
+{
+namespace
+{
+constexpr size_t blockSize = 64;
+
+// bit i is set if byte i of the block is of the given kind
+struct BlockMasks
+{
+    uint64_t quote = 0;
+    uint64_t backslash = 0;
+    uint64_t structural = 0; // { } [ ] , :
+    uint64_t whitespace = 0; // space, \t, \n and \r
+};
+
+#if defined(XRIT_UNREAL_JSON_FORMAT_SSE2)
+BlockMasks scanBlock(char const *block)
+{
+    BlockMasks masks;
+    for (size_t i = 0; i < blockSize; i += 16)
+    {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<__m128i const *>(block + i));
+        auto equals = [&](char character) { return _mm_cmpeq_epi8(bytes, _mm_set1_epi8(character)); };
+        auto toMask = [](__m128i mask) { return static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(mask))); };
+
+        // '[' and ']' are '{' and '}' without bit 0x20
+        __m128i lowered = _mm_or_si128(bytes, _mm_set1_epi8(0x20));
+        __m128i brackets = _mm_or_si128(_mm_cmpeq_epi8(lowered, _mm_set1_epi8('{')),
+                                        _mm_cmpeq_epi8(lowered, _mm_set1_epi8('}')));
+        __m128i structural = _mm_or_si128(brackets, _mm_or_si128(equals(','), equals(':')));
+        __m128i whitespace =
+            _mm_or_si128(_mm_or_si128(equals(' '), equals('\t')), _mm_or_si128(equals('\n'), equals('\r')));
+
+        masks.quote |= toMask(equals('"')) << i;
+        masks.backslash |= toMask(equals('\\')) << i;
+        masks.structural |= toMask(structural) << i;
+        masks.whitespace |= toMask(whitespace) << i;
+    }
+    return masks;
+}
+#elif defined(XRIT_UNREAL_JSON_FORMAT_NEON)
+// one bit per byte of the four comparison results (of 16 bytes each)
+uint64_t toMask(uint8x16_t const (&chunks)[4])
+{
+    uint8x16_t const bits = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80,
+                             0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80};
+    // each pairwise addition halves the amount of bytes per chunk, until each chunk is 2 bytes
+    uint8x16_t sum0 = vpaddq_u8(vandq_u8(chunks[0], bits), vandq_u8(chunks[1], bits));
+    uint8x16_t sum1 = vpaddq_u8(vandq_u8(chunks[2], bits), vandq_u8(chunks[3], bits));
+    sum0 = vpaddq_u8(sum0, sum1);
+    sum0 = vpaddq_u8(sum0, sum0);
+    return vgetq_lane_u64(vreinterpretq_u64_u8(sum0), 0);
+}
+
+BlockMasks scanBlock(char const *block)
+{
+    uint8x16_t quote[4], backslash[4], structural[4], whitespace[4];
+    for (size_t i = 0; i < 4; i++)
+    {
+        uint8x16_t bytes = vld1q_u8(reinterpret_cast<uint8_t const *>(block + i * 16));
+        auto equals = [&](char character) { return vceqq_u8(bytes, vdupq_n_u8(static_cast<uint8_t>(character))); };
+
+        // '[' and ']' are '{' and '}' without bit 0x20
+        uint8x16_t lowered = vorrq_u8(bytes, vdupq_n_u8(0x20));
+        uint8x16_t brackets = vorrq_u8(vceqq_u8(lowered, vdupq_n_u8('{')), vceqq_u8(lowered, vdupq_n_u8('}')));
+        quote[i] = equals('"');
+        backslash[i] = equals('\\');
+        structural[i] = vorrq_u8(brackets, vorrq_u8(equals(','), equals(':')));
+        whitespace[i] = vorrq_u8(vorrq_u8(equals(' '), equals('\t')), vorrq_u8(equals('\n'), equals('\r')));
+    }
+    return {.quote = toMask(quote),
+            .backslash = toMask(backslash),
+            .structural = toMask(structural),
+            .whitespace = toMask(whitespace)};
+}
+#else
+BlockMasks scanBlock(char const *block)
+{
+    BlockMasks masks;
+    for (size_t i = 0; i < blockSize; i++)
+    {
+        uint64_t bit = uint64_t(1) << i;
+        switch (block[i])
+        {
+        case '"':
+            masks.quote |= bit;
+            break;
+        case '\\':
+            masks.backslash |= bit;
+            break;
+        case '{':
+        case '}':
+        case '[':
+        case ']':
+        case ',':
+        case ':':
+            masks.structural |= bit;
+            break;
+        case ' ':
+        case '\t':
+        case '\n':
+        case '\r':
+            masks.whitespace |= bit;
+            break;
+        default:
+            break;
+        }
+    }
+    return masks;
+}
+#endif
+
+// returns the mask of the characters that are escaped by a backslash (an escaped backslash does not escape the next
+// character). escapedCarry is whether the first character of the block is escaped, and is set for the next block.
+// backslashes are rare in the json that is formatted here, so they are handled one by one
+uint64_t findEscaped(uint64_t backslash, bool &escapedCarry)
+{
+    uint64_t escaped = escapedCarry ? 1 : 0;
+    escapedCarry = false;
+    backslash &= ~escaped;
+    while (backslash != 0)
+    {
+        int index = std::countr_zero(backslash);
+        if (index == blockSize - 1)
+        {
+            escapedCarry = true;
+        }
+        else
+        {
+            escaped |= uint64_t(1) << (index + 1);
+        }
+        backslash &= ~(uint64_t(3) << index); // the backslash and the escaped character
+    }
+    return escaped;
+}
+
+// bit i is the xor of bits 0 to i, which turns the quotes into a mask of the strings (including the opening quote)
+uint64_t prefixXor(uint64_t bits)
+{
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+    return bits;
+}
+
+// calls onCharacters(index, count) for each run of whitespace outside of strings, and for each structural character
+// (with a count of 1) if Structural is true, in order. indentation is handled as a single run
+template <bool Structural, typename Function> void forEachOutsideStrings(std::string_view json, Function &&onCharacters)
+{
+    bool escapedCarry = false;
+    uint64_t inStringCarry = 0; // all bits set if the previous block ended inside a string
+
+    for (size_t offset = 0; offset < json.size(); offset += blockSize)
+    {
+        size_t remaining = json.size() - offset;
+        BlockMasks masks;
+        if (remaining >= blockSize)
+        {
+            masks = scanBlock(json.data() + offset);
+        }
+        else
+        {
+            // the last block is copied, so that nothing is read past the end of json
+            char block[blockSize];
+            std::memset(block, ' ', blockSize);
+            std::memcpy(block, json.data() + offset, remaining);
+            masks = scanBlock(block);
+        }
+
+        uint64_t quotes = masks.quote & ~findEscaped(masks.backslash, escapedCarry);
+        uint64_t inString = prefixXor(quotes) ^ inStringCarry;
+        inStringCarry = (inString >> (blockSize - 1)) != 0 ? ~uint64_t(0) : 0;
+
+        uint64_t outside = ~inString;
+        if (remaining < blockSize)
+        {
+            outside &= (uint64_t(1) << remaining) - 1;
+        }
+        uint64_t whitespace = masks.whitespace & outside;
+        uint64_t characters = whitespace;
+        if constexpr (Structural)
+        {
+            characters |= masks.structural & outside;
+        }
+
+        while (characters != 0)
+        {
+            int index = std::countr_zero(characters);
+            int count = std::countr_one(whitespace >> index); // 0 for structural characters
+            count = std::max(count, 1);
+            onCharacters(offset + index, static_cast<size_t>(count));
+            characters &= count == blockSize ? 0 : ~(((uint64_t(1) << count) - 1) << index);
+        }
+    }
+}
+} // namespace
+
+std::string prettifyJson(std::string_view json, uint32_t indentationCount, char indentationCharacter)
+{
+    std::string out;
+    out.reserve(json.size() * 2);
+
+    size_t depth = 0;
+    bool newlinePending = false; // after { [ and , the next value starts on a new line
+    auto newline = [&]() {
+        out.push_back('\n');
+        out.append(depth * indentationCount, indentationCharacter);
+        newlinePending = false;
+    };
+
+    size_t valueStart = 0; // start of the bytes since the previous structural character or whitespace
+    auto appendValue = [&](size_t end) {
+        if (end > valueStart)
+        {
+            if (newlinePending)
+            {
+                newline();
+            }
+            out.append(json.data() + valueStart, end - valueStart);
+        }
+    };
+
+    forEachOutsideStrings<true>(json, [&](size_t index, size_t count) {
+        appendValue(index);
+        valueStart = index + count;
+
+        char character = json[index];
+        switch (character)
+        {
+        case '{':
+        case '[':
+            if (newlinePending)
+            {
+                newline();
+            }
+            out.push_back(character);
+            depth++;
+            newlinePending = true;
+            break;
+        case '}':
+        case ']':
+            depth = depth > 0 ? depth - 1 : 0;
+            if (newlinePending && (out.back() == '{' || out.back() == '['))
+            {
+                newlinePending = false; // empty, so it stays on one line
+            }
+            else
+            {
+                newline();
+            }
+            out.push_back(character);
+            break;
+        case ',':
+            out.push_back(character);
+            newlinePending = true;
+            break;
+        case ':':
+            out.append(": ");
+            break;
+        default: // whitespace
+            break;
+        }
+    });
+    appendValue(json.size());
+    return out;
+}
+
+std::string minifyJson(std::string_view json)
+{
+    std::string out;
+    out.reserve(json.size());
+
+    size_t start = 0;
+    forEachOutsideStrings<false>(json, [&](size_t index, size_t count) {
+        out.append(json.data() + start, index - start);
+        start = index + count;
+    });
+    out.append(json.data() + start, json.size() - start);
+    return out;
+}
+} // namespace xrit_unreal
@@ -2,41 +2,9 @@
 
 #include <string>
 
-#include "hash.h"
+#include "reflect/hash.h"
 #include "utility.h"
 
-// hash implementations (if any of the following fields change, we should recreate the source)
-HASH_STRUCT(xrit_unreal::LiveLinkDummySourceSettings)
-HASH_FIELD(std::string_view, ip_address)
-HASH_FIELD(int64_t, port)
-HASH_STRUCT_END
-
-HASH_STRUCT(xrit_unreal::LiveLinkMvnSourceSettings)
-HASH_FIELD(int64_t, port);
-HASH_STRUCT_END
-
-// todo:
-HASH_STRUCT(xrit_unreal::LiveLinkXrSourceSettings)
-
-HASH_STRUCT_END
-
-HASH_STRUCT(xrit_unreal::VirtualSubjectSourceSettings)
-
-HASH_STRUCT_END
-
-HASH_STRUCT(xrit_unreal::LiveLinkFreeDSourceSettings)
-
-HASH_STRUCT_END
-
-HASH_STRUCT(xrit_unreal::LiveLinkMessageBusSourceSettings)
-
-HASH_STRUCT_END
-
-HASH_STRUCT(xrit_unreal::LiveLinkOptitrackSourceSettings)
-HASH_FIELD(std::string_view, server_address);
-HASH_FIELD(std::string_view, client_address);
-HASH_STRUCT_END
-
 namespace xrit_unreal
 {
 [[nodiscard]] Guid getNodeGuid(LiveLinkSourceVariants const &source)
@@ -59,9 +27,12 @@ namespace xrit_unreal
 
 std::vector<LiveLinkError> setLiveLinkSources(LiveLinkSourceCache &cache,
                                               std::vector<LiveLinkSourceVariants> const &desiredSources,
-                                              LiveLinkCallbacks const &callbacks) noexcept
+                                              LiveLinkCallbacks const &callbacks,
+                                              std::shared_ptr<StringArena const> const &strings,
+                                              LiveLinkSourceChanges *outChanges) noexcept
 {
     std::vector<LiveLinkError> errors;
+    LiveLinkSourceChanges changes;
 
     if (desiredSources.empty())
     {
@@ -69,11 +40,19 @@ std::vector<LiveLinkError> setLiveLinkSources(LiveLinkSourceCache &cache,
         for (auto &entry : cache.entries)
         {
             std::vector<LiveLinkError> removeSourceErrors = callbacks.removeSource(entry.second.unrealGuid);
+            if (removeSourceErrors.empty())
+            {
+                changes.removed++;
+            }
             append(errors, removeSourceErrors);
         }
 
         // clear cache
         cache.entries.clear();
+        if (outChanges)
+        {
+            *outChanges = changes;
+        }
         return errors;
     }
 
@@ -101,6 +80,10 @@ std::vector<LiveLinkError> setLiveLinkSources(LiveLinkSourceCache &cache,
     {
         // remove the source
         std::vector<LiveLinkError> removeSourceErrors = callbacks.removeSource(cache.entries[nodeGuid].unrealGuid);
+        if (removeSourceErrors.empty())
+        {
+            changes.removed++;
+        }
         append(errors, removeSourceErrors);
 
         // remove the cache entry
@@ -124,15 +107,14 @@ std::vector<LiveLinkError> setLiveLinkSources(LiveLinkSourceCache &cache,
             cacheEntry = &it->second;
         }
 
-        // calculate new hash
-        size_t newHash = 0;
+        // calculate new hash (of the settings that can't be updated, and the source type)
+        uint64_t newHash = 0;
         std::visit(
             [&](auto &&arg) {
                 using T = std::decay_t<decltype(arg)>;
                 if constexpr (!std::is_same_v<T, std::monostate>)
                 {
-                    using SettingsType = std::decay_t<decltype(arg.settings)>;
-                    newHash = std::hash<SettingsType>{}(arg.settings);
+                    newHash = hashValue(arg.settings, desiredSource.index());
                 }
             },
             desiredSource);
@@ -155,10 +137,12 @@ std::vector<LiveLinkError> setLiveLinkSources(LiveLinkSourceCache &cache,
             std::vector<LiveLinkError> createSourceErrors = callbacks.createSource(desiredSource, unrealId);
             if (createSourceErrors.empty())
             {
+                changes.created++;
                 // create new cache entry if we have created the new source
-                cache.entries.emplace(
-                    nodeId,
-                    LiveLinkSourceCacheEntry{.unrealGuid = unrealId, .settingsHash = newHash, .value = desiredSource});
+                cache.entries.emplace(nodeId, LiveLinkSourceCacheEntry{.unrealGuid = unrealId,
+                                                                       .settingsHash = newHash,
+                                                                       .value = desiredSource,
+                                                                       .strings = strings});
             }
             else
             {
@@ -169,14 +153,21 @@ std::vector<LiveLinkError> setLiveLinkSources(LiveLinkSourceCache &cache,
                 append(errors, createSourceErrors);
             }
         }
+        else if (desiredSource == cacheEntry->value)
+        {
+            // nothing changed, so the source does not have to be updated (the cache entry keeps its strings)
+            changes.unchanged++;
+        }
         else
         {
             std::vector<LiveLinkError> updateSourceErrors =
                 callbacks.updateSource(desiredSource, cacheEntry->unrealGuid);
             if (updateSourceErrors.empty())
             {
+                changes.updated++;
                 cacheEntry->settingsHash = newHash;
                 cacheEntry->value = desiredSource;
+                cacheEntry->strings = strings;
             }
             else
             {
@@ -190,6 +181,10 @@ std::vector<LiveLinkError> setLiveLinkSources(LiveLinkSourceCache &cache,
         }
     }
 
+    if (outChanges)
+    {
+        *outChanges = changes;
+    }
     return errors;
 }
 } // namespace xrit_unreal
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "parse_json.h"
 
+#include <cstring>
+
 namespace xrit_unreal
 {
 simdjson::error_code parseJson(std::string_view json, JsonDocument &outDocument)
@@ -13,4 +15,158 @@ simdjson::error_code parseJson(std::string_view json, JsonDocument &outDocument)
 
     return outDocument.parser.iterate(outDocument.paddedJson).get(outDocument.document);
 }
-} // namespace xrit_unreal
\ No newline at end of file
+
+PooledJsonDocument::~PooledJsonDocument()
+{
+    release();
+}
+
+PooledJsonDocument &PooledJsonDocument::operator=(PooledJsonDocument &&other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        document = std::move(other.document);
+        pool = other.pool;
+        parser = std::move(other.parser);
+    }
+    return *this;
+}
+
+void PooledJsonDocument::release()
+{
+    if (pool != nullptr && parser != nullptr)
+    {
+        // the document references the parser, so reset it before the parser can be reused
+        document = simdjson::ondemand::document();
+        pool->release(std::move(parser));
+    }
+}
+
+PooledJsonDocumentStream::~PooledJsonDocumentStream()
+{
+    release();
+}
+
+PooledJsonDocumentStream &PooledJsonDocumentStream::operator=(PooledJsonDocumentStream &&other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        stream = std::move(other.stream);
+        pool = other.pool;
+        parser = std::move(other.parser);
+    }
+    return *this;
+}
+
+void PooledJsonDocumentStream::release()
+{
+    if (pool != nullptr && parser != nullptr)
+    {
+        // the stream references the parser, so reset it before the parser can be reused
+        stream = simdjson::ondemand::document_stream();
+        pool->release(std::move(parser));
+    }
+}
+
+JsonParserPool::JsonParserPool(size_t maxCapacity) : maxCapacity(maxCapacity)
+{
+}
+
+simdjson::error_code JsonParserPool::parse(std::string_view json, PooledJsonDocument &out)
+{
+    if (json.empty())
+    {
+        return simdjson::error_code::EMPTY;
+    }
+
+    // give the parser of out back first, so that it can be reused for this document
+    out = PooledJsonDocument();
+    std::unique_ptr<PooledJsonParser> parser = acquire();
+
+    // only grows the buffer, so that documents of the same size don't allocate
+    size_t requiredCapacity = json.size() + simdjson::SIMDJSON_PADDING;
+    if (parser->bufferCapacity < requiredCapacity)
+    {
+        parser->buffer = std::make_unique_for_overwrite<char[]>(requiredCapacity);
+        parser->bufferCapacity = requiredCapacity;
+    }
+    std::memcpy(parser->buffer.get(), json.data(), json.size());
+    std::memset(parser->buffer.get() + json.size(), 0, simdjson::SIMDJSON_PADDING);
+
+    simdjson::error_code error =
+        parser->parser.iterate(parser->buffer.get(), json.size(), parser->bufferCapacity).get(out.document);
+    out.pool = this;
+    out.parser = std::move(parser);
+    return error;
+}
+
+simdjson::error_code JsonParserPool::parse(simdjson::padded_string_view json, PooledJsonDocument &out)
+{
+    if (json.empty())
+    {
+        return simdjson::error_code::EMPTY;
+    }
+
+    out = PooledJsonDocument();
+    std::unique_ptr<PooledJsonParser> parser = acquire();
+    simdjson::error_code error = parser->parser.iterate(json).get(out.document);
+    out.pool = this;
+    out.parser = std::move(parser);
+    return error;
+}
+
+simdjson::error_code JsonParserPool::parseMany(simdjson::padded_string_view json, size_t batchSize,
+                                               PooledJsonDocumentStream &out)
+{
+    out = PooledJsonDocumentStream();
+    std::unique_ptr<PooledJsonParser> parser = acquire();
+    simdjson::error_code error = parser->parser.iterate_many(json.data(), json.size(), batchSize).get(out.stream);
+    out.pool = this;
+    out.parser = std::move(parser);
+    return error;
+}
+
+size_t JsonParserPool::size() const
+{
+    std::lock_guard lock(mutex);
+    return parsers.size();
+}
+
+std::unique_ptr<PooledJsonParser> JsonParserPool::acquire()
+{
+    {
+        std::lock_guard lock(mutex);
+        if (!parsers.empty())
+        {
+            std::unique_ptr<PooledJsonParser> parser = std::move(parsers.back());
+            parsers.pop_back();
+            return parser;
+        }
+    }
+    return std::make_unique<PooledJsonParser>();
+}
+
+void JsonParserPool::release(std::unique_ptr<PooledJsonParser> parser)
+{
+    if (parser->parser.capacity() > maxCapacity || parser->bufferCapacity > maxCapacity + simdjson::SIMDJSON_PADDING)
+    {
+        return;
+    }
+    std::lock_guard lock(mutex);
+    parsers.emplace_back(std::move(parser));
+}
+
+JsonParserPool &jsonParserPool()
+{
+    static JsonParserPool pool;
+    return pool;
+}
+
+simdjson::padded_string_view padString(std::string &string)
+{
+    string.reserve(string.size() + simdjson::SIMDJSON_PADDING);
+    return simdjson::padded_string_view(string, string.capacity());
+}
+} // namespace xrit_unreal
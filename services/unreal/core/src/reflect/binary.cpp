@@ -0,0 +1,207 @@
+#include "reflect/binary.h"
+
+#include <bit>
+
+namespace xrit_unreal
+{
+BinaryReader::BinaryReader(std::string_view data, StringArena *arena) : arena(arena), data(data)
+{
+}
+
+bool BinaryReader::readVarint(uint64_t &out)
+{
+    out = 0;
+    for (size_t shift = 0; shift < 64; shift += 7)
+    {
+        if (position == data.size())
+        {
+            return false;
+        }
+        uint8_t byte = static_cast<uint8_t>(data[position++]);
+        if (shift == 63 && byte > 1)
+        {
+            return false; // the 10th byte can only hold the highest bit, the rest would not fit in 64 bits
+        }
+        out |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            return true;
+        }
+    }
+    return false; // more than 10 bytes
+}
+
+bool BinaryReader::readBytes(size_t size, std::string_view &out)
+{
+    if (size > remaining())
+    {
+        return false;
+    }
+    out = data.substr(position, size);
+    position += size;
+    return true;
+}
+
+size_t BinaryReader::remaining() const
+{
+    return data.size() - position;
+}
+
+void writeVarint(uint64_t value, std::string &out)
+{
+    while (value >= 0x80)
+    {
+        out += static_cast<char>(value | 0x80);
+        value >>= 7;
+    }
+    out += static_cast<char>(value);
+}
+
+// writes the lowest Size bytes of value, least significant first (independent of the byte order of the platform)
+template <size_t Size> static void writeLittleEndian(uint64_t value, std::string &out)
+{
+    char bytes[Size];
+    for (size_t i = 0; i < Size; i++)
+    {
+        bytes[i] = static_cast<char>(value >> (i * 8));
+    }
+    out.append(bytes, Size);
+}
+
+template <size_t Size> static bool readLittleEndian(BinaryReader &reader, uint64_t &out)
+{
+    std::string_view bytes;
+    if (!reader.readBytes(Size, bytes))
+    {
+        return false;
+    }
+    out = 0;
+    for (size_t i = 0; i < Size; i++)
+    {
+        out |= static_cast<uint64_t>(static_cast<uint8_t>(bytes[i])) << (i * 8);
+    }
+    return true;
+}
+
+// bool
+void serializeBinary(bool value, std::string &out)
+{
+    out += static_cast<char>(value ? 1 : 0);
+}
+
+bool parseBinary(BinaryReader &reader, bool &out)
+{
+    std::string_view byte;
+    if (!reader.readBytes(1, byte) || static_cast<uint8_t>(byte[0]) > 1)
+    {
+        return false;
+    }
+    out = byte[0] == 1;
+    return true;
+}
+
+// float
+void serializeBinary(float value, std::string &out)
+{
+    writeLittleEndian<4>(std::bit_cast<uint32_t>(value), out);
+}
+
+bool parseBinary(BinaryReader &reader, float &out)
+{
+    uint64_t bits;
+    if (!readLittleEndian<4>(reader, bits))
+    {
+        return false;
+    }
+    out = std::bit_cast<float>(static_cast<uint32_t>(bits));
+    return true;
+}
+
+// double
+void serializeBinary(double value, std::string &out)
+{
+    writeLittleEndian<8>(std::bit_cast<uint64_t>(value), out);
+}
+
+bool parseBinary(BinaryReader &reader, double &out)
+{
+    uint64_t bits;
+    if (!readLittleEndian<8>(reader, bits))
+    {
+        return false;
+    }
+    out = std::bit_cast<double>(bits);
+    return true;
+}
+
+// int64_t
+void serializeBinary(int64_t value, std::string &out)
+{
+    // zigzag: 0, -1, 1, -2, ... become 0, 1, 2, 3, ...
+    writeVarint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63), out);
+}
+
+bool parseBinary(BinaryReader &reader, int64_t &out)
+{
+    uint64_t value;
+    if (!reader.readVarint(value))
+    {
+        return false;
+    }
+    out = static_cast<int64_t>((value >> 1) ^ (~(value & 1) + 1));
+    return true;
+}
+
+// uint64_t
+void serializeBinary(uint64_t value, std::string &out)
+{
+    writeVarint(value, out);
+}
+
+bool parseBinary(BinaryReader &reader, uint64_t &out)
+{
+    return reader.readVarint(out);
+}
+
+// std::string_view
+void serializeBinary(std::string_view value, std::string &out)
+{
+    writeVarint(value.size(), out);
+    out += value;
+}
+
+bool parseBinary(BinaryReader &reader, std::string_view &out)
+{
+    uint64_t size;
+    if (!reader.readVarint(size) || !reader.readBytes(size, out))
+    {
+        return false;
+    }
+    if (reader.arena != nullptr)
+    {
+        out = reader.arena->store(out);
+    }
+    return true;
+}
+
+// guid
+void serializeBinary(Guid const &value, std::string &out)
+{
+    writeLittleEndian<4>(value.a, out);
+    writeLittleEndian<4>(value.b, out);
+    writeLittleEndian<4>(value.c, out);
+    writeLittleEndian<4>(value.d, out);
+}
+
+bool parseBinary(BinaryReader &reader, Guid &out)
+{
+    uint64_t a, b, c, d;
+    if (!readLittleEndian<4>(reader, a) || !readLittleEndian<4>(reader, b) || !readLittleEndian<4>(reader, c) ||
+        !readLittleEndian<4>(reader, d))
+    {
+        return false;
+    }
+    out = Guid{static_cast<uint32_t>(a), static_cast<uint32_t>(b), static_cast<uint32_t>(c), static_cast<uint32_t>(d)};
+    return true;
+}
+} // namespace xrit_unreal
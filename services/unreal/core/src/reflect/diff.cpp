@@ -0,0 +1,38 @@
+#include "reflect/diff.h"
+
+namespace xrit_unreal
+{
+DiffContext::DiffContext(Diff &out) : out(out)
+{
+    path.reserve(16);
+}
+
+void DiffContext::add(DiffOperationType type, std::string value)
+{
+    out.push_back(DiffOperation{type, jsonPointer(), std::move(value)});
+}
+
+std::string DiffContext::jsonPointer() const
+{
+    std::string out;
+    for (PathFrame const &frame : path)
+    {
+        switch (frame.type)
+        {
+        case PathFrame::Type::Key:
+            appendJsonPointerSegment(frame.key, out);
+            break;
+        case PathFrame::Type::Index:
+            out += '/';
+            out += std::to_string(frame.index);
+            break;
+        case PathFrame::Type::Guid:
+            out += '/';
+            out.resize(out.size() + guidStringLength);
+            formatGuid(frame.guid, out.data() + out.size() - guidStringLength);
+            break;
+        }
+    }
+    return out;
+}
+} // namespace xrit_unreal
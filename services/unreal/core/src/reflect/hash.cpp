@@ -0,0 +1,59 @@
+#include "reflect/hash.h"
+
+#include <bit>
+#include <cstring>
+
+namespace xrit_unreal
+{
+uint64_t hashValue(bool value, uint64_t seed)
+{
+    return combineHash(seed, value ? 1 : 0);
+}
+
+uint64_t hashValue(float value, uint64_t seed)
+{
+    // 0.0f and -0.0f are equal, so they should have the same hash
+    return combineHash(seed, value == 0.0f ? 0 : std::bit_cast<uint32_t>(value));
+}
+
+uint64_t hashValue(double value, uint64_t seed)
+{
+    return combineHash(seed, value == 0.0 ? 0 : std::bit_cast<uint64_t>(value));
+}
+
+uint64_t hashValue(int64_t value, uint64_t seed)
+{
+    return combineHash(seed, static_cast<uint64_t>(value));
+}
+
+uint64_t hashValue(uint64_t value, uint64_t seed)
+{
+    return combineHash(seed, value);
+}
+
+uint64_t hashValue(std::string_view value, uint64_t seed)
+{
+    // the size first, so that the zero padding of the last 8 bytes can't be confused with zero characters
+    seed = combineHash(seed, value.size());
+    size_t offset = 0;
+    for (; offset + 8 <= value.size(); offset += 8)
+    {
+        uint64_t bytes;
+        std::memcpy(&bytes, value.data() + offset, 8);
+        seed = combineHash(seed, bytes);
+    }
+    if (offset < value.size())
+    {
+        uint64_t bytes = 0;
+        std::memcpy(&bytes, value.data() + offset, value.size() - offset);
+        seed = combineHash(seed, bytes);
+    }
+    return seed;
+}
+
+uint64_t hashValue(Guid const &value, uint64_t seed)
+{
+    seed = combineHash(seed, (static_cast<uint64_t>(value.a) << 32) | value.b);
+    return combineHash(seed, (static_cast<uint64_t>(value.c) << 32) | value.d);
+}
+} // namespace xrit_unreal
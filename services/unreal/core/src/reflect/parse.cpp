@@ -1,5 +1,7 @@
 #include <reflect/parse.h>
 
+#include <algorithm>
+
 namespace xrit_unreal
 {
 ParseErrorCode convert(simdjson::error_code code)
@@ -46,4 +48,158 @@ ParseErrorCode convert(simdjson::error_code code)
     assert(false);
     return ParseErrorCode::Invalid;
 }
-} // namespace xrit_unreal
\ No newline at end of file
+
+ParseErrors::ParseErrors(size_t maxCount) : maxCount(maxCount)
+{
+}
+
+void ParseErrors::add(ParseError const &error)
+{
+    if (full())
+    {
+        return;
+    }
+    if (count < inlineCapacity)
+    {
+        inlineErrors[count] = error;
+    }
+    else
+    {
+        if (count == inlineCapacity)
+        {
+            // move all errors to the heap, so that the errors stay contiguous
+            heapErrors.reserve(inlineCapacity * 2);
+            heapErrors.assign(inlineErrors.begin(), inlineErrors.end());
+        }
+        heapErrors.emplace_back(error);
+    }
+    count++;
+}
+
+std::string_view ParseErrors::store(std::string string)
+{
+    return ownedStrings.emplace_front(std::move(string));
+}
+
+bool ParseErrors::full() const
+{
+    return count >= maxCount;
+}
+
+bool ParseErrors::empty() const
+{
+    return count == 0;
+}
+
+size_t ParseErrors::size() const
+{
+    return count;
+}
+
+ParseError const &ParseErrors::operator[](size_t index) const
+{
+    assert(index < count);
+    return begin()[index];
+}
+
+ParseError const *ParseErrors::begin() const
+{
+    return count > inlineCapacity ? heapErrors.data() : inlineErrors.data();
+}
+
+ParseError const *ParseErrors::end() const
+{
+    return begin() + count;
+}
+
+std::vector<ParseError> ParseErrors::toVector() const
+{
+    return {begin(), end()};
+}
+
+ParseContext::ParseContext(size_t maxErrorCount, StringArena *arena) : errors(maxErrorCount), arena(arena)
+{
+}
+
+void ParseContext::addError(ParseError error)
+{
+    if (errors.full())
+    {
+        return;
+    }
+    error.containing_object = errors.store(jsonPointer());
+    if (arena != nullptr)
+    {
+        error.value = arena->store(error.value);
+    }
+    errors.add(error);
+}
+
+void ParseContext::addError(ParseError error, std::string message)
+{
+    if (errors.full())
+    {
+        return;
+    }
+    error.message = errors.store(std::move(message));
+    addError(error);
+}
+
+std::string ParseContext::jsonPointer() const
+{
+    std::string out;
+    for (size_t i = 0; i < std::min(depth, maxDepth); i++)
+    {
+        PathFrame const &frame = path[i];
+        if (frame.key == nullptr)
+        {
+            out += '/';
+            out += std::to_string(frame.sizeOrIndex);
+            continue;
+        }
+        appendJsonPointerSegment(std::string_view(frame.key, frame.sizeOrIndex), out);
+    }
+    return out;
+}
+
+void appendJsonPointerSegment(std::string_view key, std::string &out)
+{
+    out += '/';
+    // escape according to RFC 6901
+    for (char character : key)
+    {
+        if (character == '~')
+        {
+            out += "~0";
+        }
+        else if (character == '/')
+        {
+            out += "~1";
+        }
+        else
+        {
+            out += character;
+        }
+    }
+}
+
+bool unescapeJsonPointerSegment(std::string_view segment, std::string &out)
+{
+    out.clear();
+    for (size_t i = 0; i < segment.size(); i++)
+    {
+        if (segment[i] != '~')
+        {
+            out += segment[i];
+            continue;
+        }
+        if (i + 1 == segment.size() || (segment[i + 1] != '0' && segment[i + 1] != '1'))
+        {
+            return false;
+        }
+        out += segment[i + 1] == '0' ? '~' : '/';
+        i++;
+    }
+    return true;
+}
+} // namespace xrit_unreal
@@ -1,46 +1,352 @@
 #include "reflect/serialize.h"
 
+#include <bit>
+#include <charconv>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define XRIT_UNREAL_SERIALIZE_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define XRIT_UNREAL_SERIALIZE_NEON
+#endif
+
 namespace xrit_unreal
 {
+JsonWriter::JsonWriter() : out(&owned)
+{
+}
+
+JsonWriter::JsonWriter(std::string &buffer) : out(&buffer)
+{
+}
+
+void JsonWriter::append(char character)
+{
+    out->push_back(character);
+}
+
+void JsonWriter::append(std::string_view string)
+{
+    out->append(string);
+}
+
+// formats value with std::to_chars into a stack buffer, that is large enough for any value of T
+template <typename T> static void appendCharacters(std::string &out, T value)
+{
+    char characters[32];
+    std::to_chars_result result = std::to_chars(characters, characters + sizeof(characters), value);
+    out.append(characters, result.ptr);
+}
+
+void JsonWriter::appendNumber(int64_t value)
+{
+    appendCharacters(*out, value);
+}
+
+void JsonWriter::appendNumber(uint64_t value)
+{
+    appendCharacters(*out, value);
+}
+
+void JsonWriter::appendNumber(float value)
+{
+    appendCharacters(*out, value);
+}
+
+// characters that have to be escaped in a json string
+static bool needsEscape(char character)
+{
+    auto byte = static_cast<uint8_t>(character);
+    return byte < 0x20 || character == '"' || character == '\\';
+}
+
+// returns the index of the first character at or after start that has to be escaped, or the size of the string
+// scans 16 bytes at a time when SSE2 or NEON is available, strings usually don't contain any such character
+static size_t findEscape(std::string_view string, size_t start)
+{
+    size_t i = start;
+#if defined(XRIT_UNREAL_SERIALIZE_SSE2)
+    __m128i const quote = _mm_set1_epi8('"');
+    __m128i const backslash = _mm_set1_epi8('\\');
+    __m128i const lastControl = _mm_set1_epi8(0x1F);
+    for (; i + 16 <= string.size(); i += 16)
+    {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<__m128i const *>(string.data() + i));
+        // bytes <= 0x1F (unsigned) are the bytes for which the unsigned maximum with 0x1F is 0x1F
+        __m128i control = _mm_cmpeq_epi8(_mm_max_epu8(bytes, lastControl), lastControl);
+        __m128i escape =
+            _mm_or_si128(control, _mm_or_si128(_mm_cmpeq_epi8(bytes, quote), _mm_cmpeq_epi8(bytes, backslash)));
+        auto mask = static_cast<uint32_t>(_mm_movemask_epi8(escape));
+        if (mask != 0)
+        {
+            return i + std::countr_zero(mask);
+        }
+    }
+#elif defined(XRIT_UNREAL_SERIALIZE_NEON)
+    uint8x16_t const quote = vdupq_n_u8('"');
+    uint8x16_t const backslash = vdupq_n_u8('\\');
+    uint8x16_t const lastControl = vdupq_n_u8(0x1F);
+    for (; i + 16 <= string.size(); i += 16)
+    {
+        uint8x16_t bytes = vld1q_u8(reinterpret_cast<uint8_t const *>(string.data() + i));
+        uint8x16_t escape =
+            vorrq_u8(vcleq_u8(bytes, lastControl), vorrq_u8(vceqq_u8(bytes, quote), vceqq_u8(bytes, backslash)));
+        if (vmaxvq_u8(escape) != 0)
+        {
+            // narrow each byte of the mask to 4 bits, so that the position is the number of trailing zeros / 4
+            uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(escape), 4)), 0);
+            return i + std::countr_zero(mask) / 4;
+        }
+    }
+#endif
+    for (; i < string.size(); i++)
+    {
+        if (needsEscape(string[i]))
+        {
+            return i;
+        }
+    }
+    return string.size();
+}
+
+void JsonWriter::appendString(std::string_view string)
+{
+    static constexpr char hex[] = "0123456789abcdef";
+
+    out->push_back('"');
+    size_t start = 0; // start of the characters that have not been appended yet
+    while (true)
+    {
+        size_t escape = findEscape(string, start);
+        out->append(string.data() + start, escape - start);
+        if (escape == string.size())
+        {
+            break;
+        }
+
+        char character = string[escape];
+        switch (character)
+        {
+        case '"':
+            out->append("\\\"");
+            break;
+        case '\\':
+            out->append("\\\\");
+            break;
+        case '\b':
+            out->append("\\b");
+            break;
+        case '\f':
+            out->append("\\f");
+            break;
+        case '\n':
+            out->append("\\n");
+            break;
+        case '\r':
+            out->append("\\r");
+            break;
+        case '\t':
+            out->append("\\t");
+            break;
+        default: {
+            // other control characters, as \u00XX
+            auto byte = static_cast<uint8_t>(character);
+            char escaped[] = {'\\', 'u', '0', '0', hex[byte >> 4], hex[byte & 0xF]};
+            out->append(escaped, sizeof(escaped));
+            break;
+        }
+        }
+        start = escape + 1;
+    }
+    out->push_back('"');
+}
+
+std::string_view JsonWriter::view() const
+{
+    return *out;
+}
+
+std::string &JsonWriter::buffer()
+{
+    return *out;
+}
+
+std::string JsonWriter::take() &&
+{
+    return std::move(*out);
+}
+
+// monostate (for std::variant)
+void serialize(std::monostate const &, JsonWriter &out)
+{
+    out.append("{}");
+}
+
+// bool
+void serialize(bool const &value, JsonWriter &out)
+{
+    out.append(value ? std::string_view("true") : std::string_view("false"));
+}
+
+// float
+void serialize(float const &value, JsonWriter &out)
+{
+    out.appendNumber(value);
+}
+
+// int64_t
+void serialize(int64_t const &value, JsonWriter &out)
+{
+    out.appendNumber(value);
+}
+
+// uint64_t
+void serialize(uint64_t const &value, JsonWriter &out)
+{
+    out.appendNumber(value);
+}
+
+// std::string_view
+void serialize(std::string_view const &value, JsonWriter &out)
+{
+    out.appendString(value);
+}
+
+// guid
+void serialize(Guid const &value, JsonWriter &out)
+{
+    char characters[guidStringLength + 2];
+    characters[0] = '"';
+    formatGuid(value, characters + 1);
+    characters[guidStringLength + 1] = '"';
+    out.append(std::string_view(characters, sizeof(characters)));
+}
+
+// amount of decimal digits of value
+static size_t decimalDigits(uint64_t value)
+{
+    size_t digits = 1;
+    for (; value >= 10000; value /= 10000)
+    {
+        digits += 4;
+    }
+    return digits + (value >= 10) + (value >= 100) + (value >= 1000);
+}
+
 // monostate (for std::variant)
-void serialize(std::monostate &, std::stringstream &out)
+size_t serializedSize(std::monostate const &)
 {
-    out << "{}";
+    return 2;
 }
 
 // bool
-void serialize(bool &value, std::stringstream &out)
+size_t serializedSize(bool const &value)
 {
-    out << (value ? "true" : "false");
+    return value ? 4 : 5;
 }
 
 // float
-void serialize(float &value, std::stringstream &out)
+size_t serializedSize(float const &value)
 {
-    out << value;
+    // the shortest representation depends on the value, so it is formatted the same way as in appendNumber
+    char characters[32];
+    std::to_chars_result result = std::to_chars(characters, characters + sizeof(characters), value);
+    return result.ptr - characters;
 }
 
 // int64_t
-void serialize(int64_t &value, std::stringstream &out)
+size_t serializedSize(int64_t const &value)
 {
-    out << value;
+    // the magnitude is computed unsigned, so that it also works for the minimum value
+    return value < 0 ? 1 + decimalDigits(0 - static_cast<uint64_t>(value)) : decimalDigits(value);
 }
 
 // uint64_t
-void serialize(uint64_t &value, std::stringstream &out)
+size_t serializedSize(uint64_t const &value)
+{
+    return decimalDigits(value);
+}
+
+// amount of bytes that escaping adds to a character: 1 for the backslash of short escapes, 5 for \u00XX
+static size_t escapeOverhead(char character)
 {
-    out << value;
+    switch (character)
+    {
+    case '"':
+    case '\\':
+    case '\b':
+    case '\f':
+    case '\n':
+    case '\r':
+    case '\t':
+        return 1;
+    default:
+        return needsEscape(character) ? 5 : 0;
+    }
 }
 
 // std::string_view
-void serialize(std::string_view &value, std::stringstream &out)
+size_t serializedSize(std::string_view const &value)
 {
-    out << "\"" << value << "\"";
+    // unlike appendString, this counts the escapes of a whole block at once, so strings with many escapes are not
+    // scanned again from every escape
+    size_t size = 2 + value.size(); // quotes
+    size_t i = 0;
+#if defined(XRIT_UNREAL_SERIALIZE_SSE2)
+    __m128i const lastControl = _mm_set1_epi8(0x1F);
+    for (; i + 16 <= value.size(); i += 16)
+    {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<__m128i const *>(value.data() + i));
+        auto equals = [&](char character) { return _mm_cmpeq_epi8(bytes, _mm_set1_epi8(character)); };
+        __m128i control = _mm_cmpeq_epi8(_mm_max_epu8(bytes, lastControl), lastControl);
+        __m128i quoteOrBackslash = _mm_or_si128(equals('"'), equals('\\'));
+        if (_mm_movemask_epi8(_mm_or_si128(control, quoteOrBackslash)) == 0) [[likely]]
+        {
+            continue;
+        }
+        __m128i shortEscape =
+            _mm_or_si128(quoteOrBackslash, _mm_or_si128(_mm_or_si128(equals('\b'), equals('\f')),
+                                                        _mm_or_si128(_mm_or_si128(equals('\n'), equals('\r')),
+                                                                     equals('\t'))));
+        __m128i unicodeEscape = _mm_andnot_si128(shortEscape, control);
+        // 1 per short escape and 5 per unicode escape in each byte, summed horizontally into two 64 bit halves
+        __m128i overhead = _mm_or_si128(_mm_and_si128(shortEscape, _mm_set1_epi8(1)),
+                                        _mm_and_si128(unicodeEscape, _mm_set1_epi8(5)));
+        __m128i sums = _mm_sad_epu8(overhead, _mm_setzero_si128());
+        size += static_cast<size_t>(_mm_cvtsi128_si32(sums) + _mm_cvtsi128_si32(_mm_srli_si128(sums, 8)));
+    }
+#elif defined(XRIT_UNREAL_SERIALIZE_NEON)
+    uint8x16_t const lastControl = vdupq_n_u8(0x1F);
+    for (; i + 16 <= value.size(); i += 16)
+    {
+        uint8x16_t bytes = vld1q_u8(reinterpret_cast<uint8_t const *>(value.data() + i));
+        auto equals = [&](char character) { return vceqq_u8(bytes, vdupq_n_u8(static_cast<uint8_t>(character))); };
+        uint8x16_t control = vcleq_u8(bytes, lastControl);
+        uint8x16_t quoteOrBackslash = vorrq_u8(equals('"'), equals('\\'));
+        if (vmaxvq_u8(vorrq_u8(control, quoteOrBackslash)) == 0) [[likely]]
+        {
+            continue;
+        }
+        uint8x16_t shortEscape =
+            vorrq_u8(quoteOrBackslash, vorrq_u8(vorrq_u8(equals('\b'), equals('\f')),
+                                                vorrq_u8(vorrq_u8(equals('\n'), equals('\r')), equals('\t'))));
+        uint8x16_t unicodeEscape = vbicq_u8(control, shortEscape);
+        // 1 per short escape and 5 per unicode escape in each byte, at most 5 so the sum of 16 bytes fits in a byte
+        uint8x16_t overhead = vorrq_u8(vandq_u8(shortEscape, vdupq_n_u8(1)), vandq_u8(unicodeEscape, vdupq_n_u8(5)));
+        size += vaddvq_u8(overhead);
+    }
+#endif
+    for (; i < value.size(); i++)
+    {
+        size += escapeOverhead(value[i]);
+    }
+    return size;
 }
 
 // guid
-void serialize(Guid &value, std::stringstream &out)
+size_t serializedSize(Guid const &)
 {
-    out << "\"" << serializeGuid(value) << "\"";
+    return 2 + guidStringLength; // quotes
 }
-} // namespace xrit_unreal
\ No newline at end of file
+} // namespace xrit_unreal
@@ -0,0 +1,43 @@
+#include "string_arena.h"
+
+#include <cstring>
+
+namespace xrit_unreal
+{
+StringArena::StringArena(size_t capacity)
+    : block(capacity > 0 ? std::make_unique_for_overwrite<char[]>(capacity) : nullptr), blockCapacity(capacity)
+{
+}
+
+std::string_view StringArena::store(std::string_view string)
+{
+    if (string.empty())
+    {
+        return {};
+    }
+
+    char *destination;
+    if (string.size() <= blockCapacity - blockSize)
+    {
+        destination = block.get() + blockSize;
+        blockSize += string.size();
+    }
+    else
+    {
+        destination = overflowBlocks.emplace_front(std::make_unique_for_overwrite<char[]>(string.size())).get();
+    }
+    std::memcpy(destination, string.data(), string.size());
+    storedSize += string.size();
+    return {destination, string.size()};
+}
+
+size_t StringArena::size() const
+{
+    return storedSize;
+}
+
+size_t StringArena::capacity() const
+{
+    return blockCapacity;
+}
+} // namespace xrit_unreal
@@ -132,17 +132,23 @@ static lws_ss_state_return_t receiveCallback(void *userData, uint8_t const *in,
         assert(impl->incomingMessage.empty());
     }
 
-    // add the latest received data to the string
-    std::string_view incoming((char const *)in, length);
-    impl->incomingMessage += incoming;
+    // add the latest received data to the string, while keeping room for the padding simdjson needs after the message
+    // (the capacity is kept between messages, so this only allocates when a message is larger than the ones before)
+    std::string &message = impl->incomingMessage;
+    size_t requiredCapacity = message.size() + length + simdjson::SIMDJSON_PADDING;
+    if (message.capacity() < requiredCapacity)
+    {
+        message.reserve(std::max(requiredCapacity, message.capacity() * 2));
+    }
+    message.append((char const *)in, length);
 
     if ((flags & LWSSS_FLAG_EOM) != 0)
     {
         if (listener)
         {
-            listener->onMessage(webSocket, impl->incomingMessage);
+            listener->onMessage(webSocket, simdjson::padded_string_view(message, message.capacity()));
         }
-        impl->incomingMessage.clear();
+        message.clear();
     }
 
     return LWSSSSRET_OK;
@@ -312,11 +318,16 @@ void WebSocket::run() const
 }
 
 void WebSocket::sendMessage(std::string const &message) const
+{
+    sendMessage(std::string(message));
+}
+
+void WebSocket::sendMessage(std::string &&message) const
 {
     WebSocketSecureStreamInfo *info = implementation->cachedSecureStreamInfo;
     assert(info);
 
-    implementation->messages.push({.content = message, .bytesSent = 0});
+    implementation->messages.push({.content = std::move(message), .bytesSent = 0});
     int result = lws_ss_request_tx(info->ss);
     assert(result == 0);
 }
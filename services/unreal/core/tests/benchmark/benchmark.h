@@ -0,0 +1,53 @@
+#ifndef XRIT_UNREAL_BENCHMARK_H
+#define XRIT_UNREAL_BENCHMARK_H
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <string_view>
+
+namespace xrit_unreal::benchmark
+{
+    // prevents the compiler from optimizing away the computation of value
+    template<typename T>
+    void doNotOptimize(T const& value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile T const* sink;
+        sink = &value;
+#endif
+    }
+
+    // calls function iterationCount times per round, and prints the average duration of one iteration in the fastest
+    // round (the fastest round is the least affected by other processes)
+    // returns the average duration in nanoseconds
+    template<typename Function>
+    double run(std::string_view name, size_t iterationCount, Function&& function)
+    {
+        constexpr size_t roundCount = 5;
+
+        // warm up
+        function();
+
+        double nanoseconds = std::numeric_limits<double>::max();
+        for (size_t round = 0; round < roundCount; round++)
+        {
+            auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < iterationCount; i++)
+            {
+                function();
+            }
+            auto end = std::chrono::steady_clock::now();
+            double roundNanoseconds = std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(iterationCount);
+            nanoseconds = std::min(nanoseconds, roundNanoseconds);
+        }
+
+        std::cout << name << ": " << nanoseconds << " ns" << std::endl;
+        return nanoseconds;
+    }
+}
+
+#endif // XRIT_UNREAL_BENCHMARK_H
@@ -0,0 +1,70 @@
+#include "benchmark.h"
+
+#include <xrit_unreal/data/configuration.h>
+#include <xrit_unreal/generate_mock_data.h>
+#include <xrit_unreal/parse_json.h>
+#include <xrit_unreal/reflect/binary.h>
+#include <xrit_unreal/reflect/parse.h>
+#include <xrit_unreal/reflect/serialize.h>
+
+using namespace xrit_unreal;
+
+namespace xrit_unreal::benchmark
+{
+    // compares the size, and the serialize and parse speed of the json and binary formats for the value parsed from json
+    template<typename T>
+    void benchmarkFormats(std::string_view name, std::string const& json, size_t iterationCount)
+    {
+        JsonDocument document;
+        (void)parseJson(json, document);
+        T value{};
+        (void)parse(document.document.get_value().value(), value, "");
+
+        std::string serializedJson = serializeToString(value);
+        std::string binary;
+        serializeBinary(value, binary);
+        std::cout << name << ": json " << serializedJson.size() << " bytes, binary " << binary.size() << " bytes"
+                  << std::endl;
+
+        std::string prefix(name);
+        std::string out;
+        run(prefix + " serialize json", iterationCount, [&]() {
+            out.clear(); // keeps the capacity, as a caller reusing its buffer would
+            JsonWriter writer(out);
+            serialize(value, writer);
+            doNotOptimize(out);
+        });
+        run(prefix + " serialize binary", iterationCount, [&]() {
+            out.clear(); // keeps the capacity, as a caller reusing its buffer would
+            serializeBinary(value, out);
+            doNotOptimize(out);
+        });
+
+        simdjson::padded_string paddedJson(serializedJson);
+        simdjson::ondemand::parser parser;
+        run(prefix + " parse json", iterationCount, [&]() {
+            simdjson::ondemand::document parsedDocument = parser.iterate(paddedJson);
+            T parsed{};
+            ParseErrors errors = parse(parsedDocument.get_value().value(), parsed, "");
+            doNotOptimize(parsed);
+            doNotOptimize(errors);
+        });
+        run(prefix + " parse binary", iterationCount, [&]() {
+            T parsed{};
+            bool success = parseBinary(binary, parsed);
+            doNotOptimize(parsed);
+            doNotOptimize(success);
+        });
+    }
+}
+
+int main()
+{
+    using namespace xrit_unreal::benchmark;
+
+    benchmarkFormats<Configuration>("mock configuration", generateMockConfiguration(), 20000);
+    benchmarkFormats<Configuration>("configuration with 1000 sources", generateLargeMockConfiguration(1000), 20);
+    benchmarkFormats<SetConfigurationResult>("set configuration result with parse errors",
+                                             generateMockSetConfigurationResultParseError(), 200000);
+    return 0;
+}
@@ -0,0 +1,54 @@
+#include "benchmark.h"
+
+#include <xrit_unreal/data/configuration.h>
+#include <xrit_unreal/generate_mock_data.h>
+#include <xrit_unreal/parse_json.h>
+#include <xrit_unreal/reflect/diff.h>
+
+using namespace xrit_unreal;
+
+int main()
+{
+    using namespace xrit_unreal::benchmark;
+
+    for (size_t sourceCount: {100, 1000, 10000})
+    {
+        JsonDocument document;
+        (void)parseJson(generateLargeMockConfiguration(sourceCount), document);
+        Configuration before{};
+        (void)parse(document.document.get_value().value(), before, "");
+
+        // one field of one source in the middle differs
+        Configuration after = before;
+        std::visit([](auto& source) {
+            if constexpr (!std::is_same_v<std::decay_t<decltype(source)>, std::monostate>)
+            {
+                source.subjects.push_back(1);
+            }
+        }, after.livelink.sources[sourceCount / 2]);
+
+        std::string name = "diff configurations with " + std::to_string(sourceCount) + " sources";
+        run(name + " (one changed field)", 10000000 / (sourceCount * 100), [&]() {
+            Diff changes = diff(before, after);
+            doNotOptimize(changes);
+        });
+
+        // the sources in reverse order, so that they have to be matched by id
+        Configuration reversed = after;
+        std::reverse(reversed.livelink.sources.begin(), reversed.livelink.sources.end());
+        run(name + " (one changed field, reversed sources)", 10000000 / (sourceCount * 100), [&]() {
+            Diff changes = diff(before, reversed);
+            doNotOptimize(changes);
+        });
+
+        Diff changes = diff(before, after);
+        run(name + " (patch)", 10000000 / (sourceCount * 100), [&]() {
+            Configuration patched = before;
+            StringArena strings(64);
+            bool success = patch(patched, changes, strings);
+            doNotOptimize(patched);
+            doNotOptimize(success);
+        });
+    }
+    return 0;
+}
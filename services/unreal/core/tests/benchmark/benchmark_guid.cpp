@@ -0,0 +1,70 @@
+#include "benchmark.h"
+
+#include <xrit_unreal/generate_mock_data.h>
+#include <xrit_unreal/guid.h>
+#include <xrit_unreal/reflect/serialize.h>
+
+#include <vector>
+
+using namespace xrit_unreal;
+
+namespace xrit_unreal::benchmark
+{
+    // formats and parses guidCount guids iterationCount times, and prints the duration per guid
+    void benchmarkGuid(size_t guidCount, size_t iterationCount)
+    {
+        std::vector<Guid> guids(guidCount);
+        std::vector<std::string> strings(guidCount);
+        for (size_t i = 0; i < guidCount; i++)
+        {
+            guids[i] = generateMockGuid();
+            strings[i] = serializeGuid(guids[i]);
+        }
+        auto printPerGuid = [&](double nanoseconds) {
+            std::cout << "    " << nanoseconds / static_cast<double>(guidCount) << " ns per guid" << std::endl;
+        };
+
+        printPerGuid(run("serializeGuid", iterationCount, [&]() {
+            for (Guid const& guid: guids)
+            {
+                std::string string = serializeGuid(guid);
+                doNotOptimize(string);
+            }
+        }));
+
+        printPerGuid(run("formatGuid", iterationCount, [&]() {
+            for (Guid const& guid: guids)
+            {
+                char characters[guidStringLength];
+                formatGuid(guid, characters);
+                doNotOptimize(characters);
+            }
+        }));
+
+        std::string buffer;
+        printPerGuid(run("serialize guids to json", iterationCount, [&]() {
+            buffer.clear();
+            JsonWriter out(buffer);
+            serialize(guids, out);
+            doNotOptimize(buffer);
+        }));
+
+        printPerGuid(run("tryParseGuid", iterationCount, [&]() {
+            for (std::string const& string: strings)
+            {
+                Guid guid{};
+                std::string_view error = tryParseGuid(string, guid);
+                doNotOptimize(error);
+                doNotOptimize(guid);
+            }
+        }));
+    }
+}
+
+int main()
+{
+    using namespace xrit_unreal::benchmark;
+
+    benchmarkGuid(1000, 1000);
+    return 0;
+}
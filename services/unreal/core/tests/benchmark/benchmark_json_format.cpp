@@ -0,0 +1,46 @@
+#include "benchmark.h"
+
+#include <xrit_unreal/data/configuration.h>
+#include <xrit_unreal/generate_mock_data.h>
+#include <xrit_unreal/json_format.h>
+#include <xrit_unreal/parse_json.h>
+#include <xrit_unreal/reflect/parse.h>
+#include <xrit_unreal/reflect/serialize.h>
+
+using namespace xrit_unreal;
+
+namespace xrit_unreal::benchmark
+{
+    // prettifies and minifies a configuration with sourceCount sources
+    void benchmarkFormat(size_t sourceCount, size_t iterationCount)
+    {
+        JsonDocument document;
+        (void)parseJson(generateLargeMockConfiguration(sourceCount), document);
+        Configuration configuration{};
+        (void)parse(document.document.get_value().value(), configuration, "");
+        std::string json = serializeToString(configuration);
+        std::string pretty = prettifyJson(json);
+
+        std::string prefix = "configuration with " + std::to_string(sourceCount) + " sources";
+        double nanoseconds = run("prettify " + prefix, iterationCount, [&]() {
+            std::string out = prettifyJson(json);
+            doNotOptimize(out);
+        });
+        std::cout << "    " << static_cast<double>(json.size()) / nanoseconds * 1000.0 << " MB/s" << std::endl;
+
+        nanoseconds = run("minify " + prefix, iterationCount, [&]() {
+            std::string out = minifyJson(pretty);
+            doNotOptimize(out);
+        });
+        std::cout << "    " << static_cast<double>(pretty.size()) / nanoseconds * 1000.0 << " MB/s" << std::endl;
+    }
+}
+
+int main()
+{
+    using namespace xrit_unreal::benchmark;
+
+    benchmarkFormat(10, 10000);
+    benchmarkFormat(1000, 100);
+    return 0;
+}
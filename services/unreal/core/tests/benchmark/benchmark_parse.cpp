@@ -0,0 +1,279 @@
+#include "benchmark.h"
+
+#include <xrit_unreal/data/configuration.h>
+#include <xrit_unreal/generate_mock_data.h>
+#include <xrit_unreal/parse_json.h>
+#include <xrit_unreal/reflect/parse.h>
+#include <xrit_unreal/reflect/serialize.h>
+#include <xrit_unreal/string_arena.h>
+
+#include <algorithm>
+#include <random>
+
+using namespace xrit_unreal;
+
+namespace xrit_unreal::benchmark
+{
+    // parses the json as T iterationCount times
+    template<typename T>
+    void benchmarkParse(std::string_view name, std::string const& json, size_t iterationCount)
+    {
+        simdjson::padded_string paddedJson(json);
+        simdjson::ondemand::parser parser;
+        double nanoseconds = run(name, iterationCount, [&]() {
+            simdjson::ondemand::document document = parser.iterate(paddedJson);
+            T value{};
+            ParseErrors errors = parse(document.get_value().value(), value, "");
+            doNotOptimize(value);
+            doNotOptimize(errors);
+        });
+        std::cout << "    " << static_cast<double>(json.size()) / nanoseconds * 1000.0 << " MB/s" << std::endl;
+    }
+
+    // parses the json as T iterationCount times, with the strings copied into an arena that is created for each parse
+    template<typename T>
+    void benchmarkParseWithArena(std::string_view name, std::string const& json, size_t iterationCount)
+    {
+        simdjson::padded_string paddedJson(json);
+        simdjson::ondemand::parser parser;
+        double nanoseconds = run(name, iterationCount, [&]() {
+            simdjson::ondemand::document document = parser.iterate(paddedJson);
+            StringArena arena(json.size());
+            T value{};
+            ParseErrors errors = parse(document.get_value().value(), value, "", {.arena = &arena});
+            doNotOptimize(value);
+            doNotOptimize(errors);
+        });
+        std::cout << "    " << static_cast<double>(json.size()) / nanoseconds * 1000.0 << " MB/s" << std::endl;
+    }
+
+    // parses the json as T iterationCount times into the same value, so that the storage of the previous parse gets
+    // reused
+    template<typename T>
+    void benchmarkParseInPlace(std::string_view name, std::string const& json, size_t iterationCount)
+    {
+        simdjson::padded_string paddedJson(json);
+        simdjson::ondemand::parser parser;
+        T value{};
+        double nanoseconds = run(name, iterationCount, [&]() {
+            simdjson::ondemand::document document = parser.iterate(paddedJson);
+            ParseErrors errors = parse(document.get_value().value(), value, "");
+            doNotOptimize(value);
+            doNotOptimize(errors);
+        });
+        std::cout << "    " << static_cast<double>(json.size()) / nanoseconds * 1000.0 << " MB/s" << std::endl;
+    }
+
+    // parses the json message as T iterationCount times, including setting up the parser, either with a new parser for
+    // each message or with a parser from a pool
+    template<typename T>
+    void benchmarkParseMessage(std::string_view name, std::string const& json, size_t iterationCount, bool pooled)
+    {
+        JsonParserPool pool;
+        double nanoseconds = run(name, iterationCount, [&]() {
+            T value{};
+            if (pooled)
+            {
+                PooledJsonDocument document;
+                (void)pool.parse(json, document);
+                ParseErrors errors = parse(document.document.get_value().value(), value, "");
+                doNotOptimize(errors);
+            }
+            else
+            {
+                JsonDocument document;
+                (void)parseJson(json, document);
+                ParseErrors errors = parse(document.document.get_value().value(), value, "");
+                doNotOptimize(errors);
+            }
+            doNotOptimize(value);
+        });
+        std::cout << "    " << static_cast<double>(json.size()) / nanoseconds * 1000.0 << " MB/s" << std::endl;
+    }
+
+    // newline delimited json of documentCount configurations of different sizes, as a replayed configuration history
+    std::string generateConfigurationHistory(size_t documentCount)
+    {
+        std::string ndjson;
+        for (size_t i = 0; i < documentCount; i++)
+        {
+            Configuration configuration{};
+            JsonDocument document;
+            (void)parseJson(generateLargeMockConfiguration(i % 50 + 1), document);
+            (void)parse(document.document.get_value().value(), configuration, "");
+            ndjson += serializeToString(configuration) + "\n";
+        }
+        return ndjson;
+    }
+
+    // parses all documents of the newline delimited json as T iterationCount times, either as one stream or with a
+    // separate parseJson per line
+    template<typename T>
+    void benchmarkParseMany(std::string_view name, std::string const& ndjson, size_t iterationCount, bool stream)
+    {
+        simdjson::padded_string paddedJson(ndjson);
+        double nanoseconds = run(name, iterationCount, [&]() {
+            if (stream)
+            {
+                simdjson::error_code error = parseMany<T>(paddedJson, [](T& value, ParseErrors& errors) {
+                    doNotOptimize(value);
+                    doNotOptimize(errors);
+                });
+                doNotOptimize(error);
+                return;
+            }
+            std::string_view remaining = ndjson;
+            while (!remaining.empty())
+            {
+                size_t end = remaining.find('\n');
+                JsonDocument document;
+                (void)parseJson(remaining.substr(0, end), document);
+                T value{};
+                ParseErrors errors = parse(document.document.get_value().value(), value, "");
+                doNotOptimize(value);
+                doNotOptimize(errors);
+                remaining.remove_prefix(end + 1);
+            }
+        });
+        std::cout << "    " << static_cast<double>(ndjson.size()) / nanoseconds << " GB/s" << std::endl;
+    }
+
+    // returns the json object with its (top level) fields reordered by reorder, which gets a vector of "key":value
+    template<typename Reorder>
+    std::string reorderFields(std::string const& json, Reorder&& reorder)
+    {
+        simdjson::padded_string paddedJson(json);
+        simdjson::ondemand::parser parser;
+        simdjson::ondemand::document document = parser.iterate(paddedJson);
+        std::vector<std::string> fields;
+        for (auto field: document.get_object())
+        {
+            std::string_view key = field.key_raw_json_token();
+            std::string_view value = field.value().raw_json();
+            fields.emplace_back(std::string(key) + ":" + std::string(value));
+        }
+        reorder(fields);
+        std::string out = "{";
+        for (size_t i = 0; i < fields.size(); i++)
+        {
+            out += (i == 0 ? "" : ",") + fields[i];
+        }
+        return out + "}";
+    }
+
+    // fields in reverse order, so the next field is never the expected one
+    std::string reverseFields(std::string const& json)
+    {
+        return reorderFields(json, [](std::vector<std::string>& fields) { std::reverse(fields.begin(), fields.end()); });
+    }
+
+    // fields in random (but deterministic) order
+    std::string shuffleFields(std::string const& json)
+    {
+        return reorderFields(json, [](std::vector<std::string>& fields) {
+            std::mt19937 random(1234);
+            std::shuffle(fields.begin(), fields.end(), random);
+        });
+    }
+
+    // fields in order, except that every fourth field is swapped with the next one, as if some fields were added in a
+    // different order
+    std::string partiallyOrderFields(std::string const& json)
+    {
+        return reorderFields(json, [](std::vector<std::string>& fields) {
+            for (size_t i = 0; i + 1 < fields.size(); i += 4)
+            {
+                std::swap(fields[i], fields[i + 1]);
+            }
+        });
+    }
+
+    // serializes the value iterationCount times
+    template<typename T>
+    void benchmarkSerialize(std::string_view name, T& value, size_t iterationCount)
+    {
+        size_t size = 0;
+        double nanoseconds = run(name, iterationCount, [&]() {
+            std::string out = serializeToString(value);
+            size = out.size();
+            doNotOptimize(out);
+        });
+        std::cout << "    " << static_cast<double>(size) / nanoseconds * 1000.0 << " MB/s" << std::endl;
+    }
+
+    // json of a livelink configuration with sourceCount sources that cycle through all source types, without any fields
+    // other than $type, so that parsing it is dominated by finding the type of each variant
+    std::string generateSourceTypes(size_t sourceCount)
+    {
+        std::vector<std::string_view> names;
+        std::apply([&](auto&&... types) { (names.emplace_back(classInfo<std::decay_t<decltype(types)>>().name), ...); },
+                   std::tuple<LiveLinkDummySource, LiveLinkMvnSource, LiveLinkOptitrackSource, LiveLinkXrSource,
+                              VirtualSubjectSource, LiveLinkFreeDSource, LiveLinkMessageBusSource>{});
+        std::string json = R"({"sources":[)";
+        for (size_t i = 0; i < sourceCount; i++)
+        {
+            json += (i == 0 ? "" : ",");
+            json += R"({"$type":")" + std::string(names[i % names.size()]) + "\"}";
+        }
+        return json + "]}";
+    }
+
+    // looks up every field key of T iterationCount times
+    template<typename T>
+    void benchmarkFieldLookup(std::string_view name, size_t iterationCount)
+    {
+        std::vector<std::string> keys;
+        std::apply([&](auto&&... fields) { (keys.emplace_back(fields.key), ...); }, classInfo<T>().fields);
+        double nanoseconds = run(name, iterationCount, [&]() {
+            for (std::string const& key: keys)
+            {
+                size_t index = fieldLookup<T>.find(key);
+                doNotOptimize(index);
+            }
+        });
+        std::cout << "    " << nanoseconds / static_cast<double>(keys.size()) << " ns per key" << std::endl;
+    }
+}
+
+int main()
+{
+    using namespace xrit_unreal::benchmark;
+
+    // buffer settings (12 fields)
+    LiveLinkSourceBufferManagementSettings bufferSettings{};
+    std::string bufferSettingsJson = serializeToString(bufferSettings);
+    benchmarkParse<LiveLinkSourceBufferManagementSettings>("parse LiveLinkSourceBufferManagementSettings", bufferSettingsJson, 200000);
+    benchmarkParse<LiveLinkSourceBufferManagementSettings>("parse LiveLinkSourceBufferManagementSettings (partially ordered fields)", partiallyOrderFields(bufferSettingsJson), 200000);
+    benchmarkParse<LiveLinkSourceBufferManagementSettings>("parse LiveLinkSourceBufferManagementSettings (shuffled fields)", shuffleFields(bufferSettingsJson), 200000);
+    benchmarkParse<LiveLinkSourceBufferManagementSettings>("parse LiveLinkSourceBufferManagementSettings (reversed fields)", reverseFields(bufferSettingsJson), 200000);
+    benchmarkFieldLookup<LiveLinkSourceBufferManagementSettings>("look up LiveLinkSourceBufferManagementSettings fields", 1000000);
+
+    benchmarkParse<Configuration>("parse mock configuration", generateMockConfiguration(), 20000);
+    benchmarkParseWithArena<Configuration>("parse mock configuration (string arena)", generateMockConfiguration(), 20000);
+    benchmarkParseMessage<Configuration>("parse mock configuration message (new parser)", generateMockConfiguration(), 20000, false);
+    benchmarkParseMessage<Configuration>("parse mock configuration message (parser pool)", generateMockConfiguration(), 20000, true);
+
+    benchmarkParse<LiveLink>("parse 1000 sources of mixed types without fields", generateSourceTypes(1000), 2000);
+
+    std::string history = generateConfigurationHistory(1000);
+    benchmarkParseMany<Configuration>("parse configuration history (parseJson per document)", history, 5, false);
+    benchmarkParseMany<Configuration>("parse configuration history (parseMany)", history, 5, true);
+
+    for (size_t sourceCount: {100, 1000, 10000})
+    {
+        std::string name = "parse configuration with " + std::to_string(sourceCount) + " sources";
+        std::string json = generateLargeMockConfiguration(sourceCount);
+        benchmarkParse<Configuration>(name, json, 20000 / sourceCount);
+        benchmarkParseInPlace<Configuration>(name + " (in place)", json, 20000 / sourceCount);
+        benchmarkParseMessage<Configuration>(name + " message (new parser)", json, 20000 / sourceCount, false);
+        benchmarkParseMessage<Configuration>(name + " message (parser pool)", json, 20000 / sourceCount, true);
+
+        // the sources are of mixed types, so each one is written through the $type dispatch of the variant
+        JsonDocument document;
+        (void)parseJson(json, document);
+        Configuration configuration{};
+        (void)parse(document.document.get_value().value(), configuration, "");
+        benchmarkSerialize(std::string("serialize configuration with ") + std::to_string(sourceCount) + " sources", configuration, 20000 / sourceCount);
+    }
+    return 0;
+}
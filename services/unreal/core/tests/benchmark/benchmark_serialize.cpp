@@ -0,0 +1,138 @@
+#include "benchmark.h"
+
+#include <xrit_unreal/data/communication_protocol.h>
+#include <xrit_unreal/data/configuration.h>
+#include <xrit_unreal/generate_mock_data.h>
+#include <xrit_unreal/livelink.h>
+#include <xrit_unreal/parse_json.h>
+#include <xrit_unreal/reflect/parse.h>
+#include <xrit_unreal/reflect/serialize.h>
+#include <xrit_unreal/status.h>
+
+using namespace xrit_unreal;
+
+namespace xrit_unreal::benchmark
+{
+    // serializes the value parsed from json iterationCount times, into a new string that grows while writing, into a
+    // new string that is allocated once with the size from serializedSize, and into a reused buffer
+    template<typename T>
+    void benchmarkSerialize(std::string_view name, std::string const& json, size_t iterationCount)
+    {
+        JsonDocument document;
+        (void)parseJson(json, document);
+        T value{};
+        (void)parse(document.document.get_value().value(), value, "");
+        size_t size = serializeToString(value).size();
+
+        std::string prefix(name);
+        double nanoseconds = run(prefix + " (new string)", iterationCount, [&]() {
+            std::string out = serializeToString(value);
+            doNotOptimize(out);
+        });
+        std::cout << "    " << static_cast<double>(size) / nanoseconds * 1000.0 << " MB/s" << std::endl;
+
+        run(prefix + " (size only)", iterationCount, [&]() {
+            size_t exactSize = serializedSize(value);
+            doNotOptimize(exactSize);
+        });
+
+        nanoseconds = run(prefix + " (new string, exact size)", iterationCount, [&]() {
+            std::string out;
+            out.reserve(serializedSize(value));
+            JsonWriter writer(out);
+            serialize(value, writer);
+            doNotOptimize(out);
+        });
+        std::cout << "    " << static_cast<double>(size) / nanoseconds * 1000.0 << " MB/s" << std::endl;
+
+        std::string buffer;
+        nanoseconds = run(prefix + " (reused buffer)", iterationCount, [&]() {
+            buffer.clear(); // keeps the capacity
+            JsonWriter out(buffer);
+            serialize(value, out);
+            doNotOptimize(buffer);
+        });
+        std::cout << "    " << static_cast<double>(size) / nanoseconds * 1000.0 << " MB/s" << std::endl;
+    }
+
+    // serializes the status of a cache with sourceCount sources, by copying the sources into a configuration (as the
+    // plugin used to), and through a view of the cache
+    void benchmarkStatus(size_t sourceCount, size_t iterationCount)
+    {
+        JsonDocument document;
+        (void)parseJson(generateLargeMockConfiguration(sourceCount), document);
+        Configuration configuration{};
+        (void)parse(document.document.get_value().value(), configuration, "");
+
+        LiveLinkSourceCache cache{};
+        LiveLinkCallbacks callbacks{
+            .removeSource = [](Guid) -> std::vector<LiveLinkError> { return {}; },
+            .createSource = [](LiveLinkSourceVariants const&, Guid& outUnrealId) -> std::vector<LiveLinkError> {
+                outUnrealId = generateMockGuid();
+                return {};
+            },
+            .updateSource = [](LiveLinkSourceVariants const&, Guid) -> std::vector<LiveLinkError> { return {}; }
+        };
+        (void)setLiveLinkSources(cache, configuration.livelink.sources, callbacks);
+
+        std::string prefix = "serialize status with " + std::to_string(sourceCount) + " sources";
+        std::string buffer;
+        run(prefix + " (copy)", iterationCount, [&]() {
+            Configuration status{};
+            for (auto const& entry: cache.entries)
+            {
+                status.livelink.sources.emplace_back(entry.second.value);
+            }
+            buffer.clear();
+            JsonWriter out(buffer);
+            serialize(status, out);
+            doNotOptimize(buffer);
+        });
+        run(prefix + " (view)", iterationCount, [&]() {
+            StatusView status{.livelink{.sources{cache.entries}}};
+            buffer.clear();
+            JsonWriter out(buffer);
+            serialize(status, out);
+            doNotOptimize(buffer);
+        });
+    }
+
+    // json array of count strings, each string is text repeated until it is length characters long
+    std::string generateStrings(std::string_view text, size_t length, size_t count)
+    {
+        std::string string;
+        while (string.size() < length)
+        {
+            string += text;
+        }
+        std::string json = "[";
+        for (size_t i = 0; i < count; i++)
+        {
+            json += (i == 0 ? "\"" : ",\"") + string + "\"";
+        }
+        return json + "]";
+    }
+}
+
+int main()
+{
+    using namespace xrit_unreal::benchmark;
+
+    benchmarkSerialize<Configuration>("serialize mock configuration", generateMockConfiguration(), 100000);
+    benchmarkSerialize<Configuration>("serialize configuration with 1000 sources", generateLargeMockConfiguration(1000),
+                                      100);
+    benchmarkSerialize<SetConfigurationResult>("serialize set configuration result",
+                                               generateMockSetConfigurationResultSuccess(), 1000000);
+    benchmarkSerialize<SetConfigurationResult>("serialize set configuration result with parse errors",
+                                               generateMockSetConfigurationResultParseError(), 1000000);
+
+    benchmarkStatus(10, 100000);
+    benchmarkStatus(1000, 100);
+
+    // strings without any characters to escape, and with escaped characters
+    benchmarkSerialize<std::vector<std::string_view>>("serialize strings",
+                                                      generateStrings("LiveLink source machine ", 256, 1000), 1000);
+    benchmarkSerialize<std::vector<std::string_view>>("serialize strings with escapes",
+                                                      generateStrings(R"(C:\\path \"quoted\"\n)", 256, 1000), 1000);
+    return 0;
+}
@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+
+#include <xrit_unreal/data/configuration.h>
+#include <xrit_unreal/generate_mock_data.h>
+#include <xrit_unreal/parse_json.h>
+#include <xrit_unreal/reflect/binary.h>
+#include <xrit_unreal/reflect/parse.h>
+#include <xrit_unreal/reflect/serialize.h>
+
+#include <limits>
+
+using namespace xrit_unreal;
+
+namespace xrit_unreal::binary_tests
+{
+    // parses the json as T, writes it in the binary format, parses that back, and checks that serializing it to json
+    // gives the same json as the value parsed from the original json
+    template<typename T>
+    void testRoundTrip(std::string const& json)
+    {
+        JsonDocument document;
+        ASSERT_EQ(parseJson(json, document), simdjson::SUCCESS);
+        T value{};
+        ASSERT_TRUE(parse(document.document.get_value().value(), value, "").empty());
+
+        std::string binary;
+        serializeBinary(value, binary);
+        T parsed{};
+        ASSERT_TRUE(parseBinary(binary, parsed));
+
+        std::string expected = serializeToString(value);
+        ASSERT_EQ(serializeToString(parsed), expected);
+        ASSERT_LT(binary.size(), expected.size());
+    }
+
+    TEST(Binary, ConfigurationRoundTrip)
+    {
+        testRoundTrip<Configuration>(generateMockConfiguration());
+        testRoundTrip<Configuration>(generateLargeMockConfiguration(100)); // all source types
+    }
+
+    TEST(Binary, SetConfigurationResultRoundTrip)
+    {
+        testRoundTrip<SetConfigurationResult>(generateMockSetConfigurationResultSuccess());
+        testRoundTrip<SetConfigurationResult>(generateMockSetConfigurationResultParseError());
+    }
+
+    TEST(Binary, BuiltInTypes)
+    {
+        std::string binary;
+        for (int64_t value: {int64_t{0}, int64_t{-1}, int64_t{1}, int64_t{-64}, int64_t{64},
+                             std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()})
+        {
+            binary.clear();
+            serializeBinary(value, binary);
+            int64_t parsed = 0;
+            ASSERT_TRUE(parseBinary(binary, parsed));
+            ASSERT_EQ(parsed, value);
+        }
+
+        for (uint64_t value: {uint64_t{0}, uint64_t{127}, uint64_t{128}, std::numeric_limits<uint64_t>::max()})
+        {
+            binary.clear();
+            serializeBinary(value, binary);
+            uint64_t parsed = 0;
+            ASSERT_TRUE(parseBinary(binary, parsed));
+            ASSERT_EQ(parsed, value);
+        }
+
+        // small values take one byte
+        binary.clear();
+        serializeBinary(int64_t{-64}, binary);
+        ASSERT_EQ(binary.size(), 1);
+
+        binary.clear();
+        serializeBinary(2.5f, binary);
+        ASSERT_EQ(binary, std::string("\x00\x00\x20\x40", 4));
+        float parsedFloat = 0.0f;
+        ASSERT_TRUE(parseBinary(binary, parsedFloat));
+        ASSERT_EQ(parsedFloat, 2.5f);
+
+        binary.clear();
+        Guid guid{0x01020304, 5, 6, 0xFFFFFFFF};
+        serializeBinary(guid, binary);
+        ASSERT_EQ(binary.size(), 16);
+        Guid parsedGuid{};
+        ASSERT_TRUE(parseBinary(binary, parsedGuid));
+        ASSERT_EQ(parsedGuid, guid);
+    }
+
+    TEST(Binary, InvalidData)
+    {
+        LiveLinkXrSource source{.id{1, 2, 3, 4}, .settings{.track_hmds = true}, .subjects{1, 2, 3}};
+        std::string binary;
+        serializeBinary(source, binary);
+
+        LiveLinkXrSource parsed;
+        ASSERT_TRUE(parseBinary(binary, parsed));
+
+        // ends too early
+        for (size_t size = 0; size < binary.size(); size++)
+        {
+            ASSERT_FALSE(parseBinary(std::string_view(binary).substr(0, size), parsed));
+        }
+
+        // bytes left after the value
+        ASSERT_FALSE(parseBinary(binary + '\0', parsed));
+
+        // vector count larger than the data
+        std::string count;
+        writeVarint(std::numeric_limits<uint64_t>::max(), count);
+        std::vector<uint64_t> list;
+        ASSERT_FALSE(parseBinary(count, list));
+
+        // enum value out of range
+        std::string enumValue;
+        writeVarint(static_cast<uint64_t>(LiveLinkSourceMode::Count), enumValue);
+        LiveLinkSourceMode mode;
+        ASSERT_FALSE(parseBinary(enumValue, mode));
+
+        // invalid enum value, like when parsing json
+        ASSERT_FALSE(parseBinary(std::string_view("\x00", 1), mode));
+
+        // varint that does not fit in 64 bits
+        uint64_t number;
+        ASSERT_TRUE(parseBinary(std::string_view("\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\x01", 10), number));
+        ASSERT_EQ(number, std::numeric_limits<uint64_t>::max());
+        ASSERT_FALSE(parseBinary(std::string_view("\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\x02", 10), number));
+        ASSERT_FALSE(parseBinary(std::string_view("\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\x7F", 10), number));
+
+        // variant index out of range
+        std::string variantIndex;
+        writeVarint(std::variant_size_v<LiveLinkSourceVariants>, variantIndex);
+        LiveLinkSourceVariants variant;
+        ASSERT_FALSE(parseBinary(variantIndex, variant));
+
+        // bool that is not 0 or 1
+        bool boolean;
+        ASSERT_FALSE(parseBinary(std::string_view("\x02", 1), boolean));
+    }
+
+    TEST(Binary, ParseOutlivesData)
+    {
+        LiveLinkDummySource source{.settings{.ip_address = "10.10.10.10"}};
+        std::string binary;
+        serializeBinary(source, binary);
+
+        // without arena the string references the data
+        LiveLinkDummySource parsed;
+        ASSERT_TRUE(parseBinary(binary, parsed));
+        ASSERT_GE(parsed.settings.ip_address.data(), binary.data());
+        ASSERT_LT(parsed.settings.ip_address.data(), binary.data() + binary.size());
+
+        StringArena arena(binary.size());
+        ASSERT_TRUE(parseBinary(binary, parsed, &arena));
+        binary.assign(binary.size(), '\0');
+        ASSERT_EQ(parsed.settings.ip_address, "10.10.10.10");
+    }
+}
@@ -1,6 +1,11 @@
 #include <gtest/gtest.h>
 
 #include <xrit_unreal/communication_protocol.h>
+#include <xrit_unreal/data/configuration.h>
+#include <xrit_unreal/generate_mock_data.h>
+#include <xrit_unreal/parse_json.h>
+#include <xrit_unreal/reflect/parse.h>
+#include <xrit_unreal/reflect/serialize.h>
 
 namespace xrit_unreal::service_tests
 {
@@ -9,31 +14,34 @@ namespace xrit_unreal::service_tests
         // message with data
         std::string message1 = "unreal_to_node:some_command_here\ndata_here";
         MessageData data1;
-        bool success1 = getMessageData(message1, &data1);
+        bool success1 = getMessageData(padString(message1), &data1);
         ASSERT_TRUE(success1);
         ASSERT_EQ(data1.channel, "unreal_to_node");
         ASSERT_EQ(data1.command, "some_command_here");
         ASSERT_EQ(data1.data, "data_here");
+        // the data keeps the padding after the message, so it can be parsed without copying
+        ASSERT_GE(data1.data.padding(), simdjson::SIMDJSON_PADDING);
 
         // message without data
         std::string message2 = "unreal_to_node:other_command";
         MessageData data2;
-        bool success2 = getMessageData(message2, &data2);
+        bool success2 = getMessageData(padString(message2), &data2);
         ASSERT_TRUE(success2);
         ASSERT_EQ(data2.channel, "unreal_to_node");
         ASSERT_EQ(data2.command, "other_command");
         ASSERT_EQ(data2.data, std::string_view());
+        ASSERT_GE(data2.data.padding(), simdjson::SIMDJSON_PADDING);
 
         // ill formed message
         std::string message3 = "ill_formed_message";
         MessageData data3;
-        bool success3 = getMessageData(message3, &data3);
+        bool success3 = getMessageData(padString(message3), &data3);
         ASSERT_FALSE(success3);
 
         // message without data, but with return
         std::string message4 = "unreal_to_node:no_data_with_return\n";
         MessageData data4;
-        bool success4 = getMessageData(message4, &data4);
+        bool success4 = getMessageData(padString(message4), &data4);
         ASSERT_TRUE(success4);
         ASSERT_EQ(data4.channel, "unreal_to_node");
         ASSERT_EQ(data4.command, "no_data_with_return");
@@ -44,11 +52,158 @@ namespace xrit_unreal::service_tests
     {
         std::string message1 = "node_to_unreal:set_configuration\n{}";
         MessageData data1;
-        ASSERT_TRUE(getMessageData(message1, &data1));
+        ASSERT_TRUE(getMessageData(padString(message1), &data1));
         UnrealMessageData unrealData1;
         ASSERT_TRUE(getUnrealMessage(data1, unrealData1));
 
         ASSERT_EQ(createNodeMessage(NodeCommand::initialized, "some data"), "unreal_to_node:initialized\nsome data");
         ASSERT_EQ(createNodeMessage(NodeCommand::initialized, ""), "unreal_to_node:initialized");
     }
+
+    TEST(Service, NodeMessageBuilder)
+    {
+        // payload is serialized directly after the header
+        Capabilities capabilities{.batching = true};
+        NodeMessageBuilder builder(NodeCommand::initialized);
+        serialize(capabilities, builder.payload());
+        ASSERT_EQ(std::move(builder).finish(), createNodeMessage(NodeCommand::initialized, serializeCapabilities(capabilities)));
+
+        // the reserved buffer is moved out of the builder
+        NodeMessageBuilder reserved(NodeCommand::status, 1024);
+        reserved.payload().append("{}");
+        std::string message = std::move(reserved).finish();
+        ASSERT_EQ(message, "unreal_to_node:status\n{}");
+        ASSERT_GE(message.capacity(), 1024);
+
+        // without payload
+        NodeMessageBuilder empty(NodeCommand::status);
+        ASSERT_EQ(std::move(empty).finish(), "unreal_to_node:status");
+    }
+
+    TEST(Service, NodeMessageBuilderExactSize)
+    {
+        JsonDocument document;
+        ASSERT_EQ(parseJson(generateLargeMockConfiguration(100), document), simdjson::SUCCESS);
+        Configuration configuration{};
+        ASSERT_TRUE(parse(document.document.get_value().value(), configuration, "").empty());
+
+        // the payload fits exactly into the reserved buffer, which is allocated once
+        size_t size = serializedSize(configuration);
+        NodeMessageBuilder builder(NodeCommand::status, size);
+        std::string const& message = builder.payload().buffer();
+        char const* data = message.data();
+        size_t headerSize = message.size();
+        serialize(configuration, builder.payload());
+        ASSERT_EQ(message.size(), headerSize + size);
+        ASSERT_EQ(message.data(), data);
+        ASSERT_EQ(std::move(builder).finish(), createNodeMessage(NodeCommand::status, serializeToString(configuration)));
+
+        JsonDocument resultDocument;
+        ASSERT_EQ(parseJson(generateMockSetConfigurationResultParseError(), resultDocument), simdjson::SUCCESS);
+        SetConfigurationResult result{};
+        ASSERT_TRUE(parse(resultDocument.document.get_value().value(), result, "").empty());
+        ASSERT_EQ(serializedSize(result), serializeToString(result).size());
+    }
+
+    // creates the capabilities for the given combination of bits, one bit per boolean feature
+    Capabilities capabilitiesFromBits(uint32_t bits, uint64_t heartbeatIntervalMs)
+    {
+        return Capabilities{
+            .compression = (bits & 1) != 0,
+            .binary_envelope = (bits & 2) != 0,
+            .delta_status = (bits & 4) != 0,
+            .batching = (bits & 8) != 0,
+            .heartbeat_interval_ms = heartbeatIntervalMs
+        };
+    }
+
+    TEST(Service, NegotiateCapabilities)
+    {
+        constexpr uint32_t combinationCount = 16; // 4 boolean features
+        std::vector<uint64_t> heartbeatIntervals{0, 500, 1000};
+
+        for (uint32_t localBits = 0; localBits < combinationCount; localBits++)
+        {
+            for (uint32_t remoteBits = 0; remoteBits < combinationCount; remoteBits++)
+            {
+                for (uint64_t localHeartbeat: heartbeatIntervals)
+                {
+                    for (uint64_t remoteHeartbeat: heartbeatIntervals)
+                    {
+                        Capabilities local = capabilitiesFromBits(localBits, localHeartbeat);
+                        Capabilities remote = capabilitiesFromBits(remoteBits, remoteHeartbeat);
+
+                        // the unreal service sends its capabilities to the node in the initialized message
+                        std::string initialized = createNodeMessage(NodeCommand::initialized, serializeCapabilities(local));
+                        MessageData initializedData;
+                        ASSERT_TRUE(getMessageData(padString(initialized), &initializedData));
+                        NodeMessageData nodeMessage;
+                        ASSERT_TRUE(getNodeMessage(initializedData, nodeMessage));
+                        ASSERT_EQ(nodeMessage.command, NodeCommand::initialized);
+                        Capabilities receivedByNode;
+                        ASSERT_TRUE(parseCapabilities(nodeMessage.data, receivedByNode));
+
+                        // the node replies with its own capabilities
+                        std::string reply = createMockUnrealMessage(UnrealCommand::capabilities, serializeCapabilities(remote));
+                        MessageData replyData;
+                        ASSERT_TRUE(getMessageData(padString(reply), &replyData));
+                        UnrealMessageData unrealMessage;
+                        ASSERT_TRUE(getUnrealMessage(replyData, unrealMessage));
+                        ASSERT_EQ(unrealMessage.command, UnrealCommand::capabilities);
+                        Capabilities receivedByUnreal;
+                        ASSERT_TRUE(parseCapabilities(unrealMessage.data, receivedByUnreal));
+
+                        // both sides should settle on the same features
+                        Capabilities node = negotiateCapabilities(remote, receivedByNode);
+                        Capabilities unreal = negotiateCapabilities(local, receivedByUnreal);
+                        Capabilities expected = capabilitiesFromBits(localBits & remoteBits,
+                            localHeartbeat != 0 && remoteHeartbeat != 0 ? std::max(localHeartbeat, remoteHeartbeat) : 0);
+
+                        for (Capabilities const& result: {node, unreal})
+                        {
+                            ASSERT_EQ(result.compression, expected.compression);
+                            ASSERT_EQ(result.binary_envelope, expected.binary_envelope);
+                            ASSERT_EQ(result.delta_status, expected.delta_status);
+                            ASSERT_EQ(result.batching, expected.batching);
+                            ASSERT_EQ(result.heartbeat_interval_ms, expected.heartbeat_interval_ms);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    TEST(Service, CapabilitiesOlderPeer)
+    {
+        Capabilities all = capabilitiesFromBits(15, 1000);
+
+        // an older unreal service sends initialized without payload
+        std::string initialized = createNodeMessage(NodeCommand::initialized, "");
+        MessageData data;
+        ASSERT_TRUE(getMessageData(padString(initialized), &data));
+        Capabilities received = all;
+        ASSERT_TRUE(parseCapabilities(data.data, received));
+
+        // which results in the text protocol without any optional features
+        Capabilities negotiated = negotiateCapabilities(all, received);
+        ASSERT_FALSE(negotiated.compression);
+        ASSERT_FALSE(negotiated.binary_envelope);
+        ASSERT_FALSE(negotiated.delta_status);
+        ASSERT_FALSE(negotiated.batching);
+        ASSERT_EQ(negotiated.heartbeat_interval_ms, 0);
+    }
+
+    TEST(Service, CapabilitiesNewerPeer)
+    {
+        // unknown capabilities of newer peers are ignored
+        Capabilities received;
+        ASSERT_TRUE(parseCapabilities(R"({"compression": true, "some_future_feature": true, "batching": true})", received));
+        ASSERT_TRUE(received.compression);
+        ASSERT_TRUE(received.batching);
+        ASSERT_FALSE(received.delta_status);
+
+        // ill-formed capabilities
+        ASSERT_FALSE(parseCapabilities(R"({"compression": 12})", received));
+        ASSERT_FALSE(parseCapabilities("not json", received));
+    }
 }
\ No newline at end of file
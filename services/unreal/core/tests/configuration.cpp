@@ -5,8 +5,39 @@
 #include <xrit_unreal/parse_json.h>
 #include <xrit_unreal/reflect/parse.h>
 
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
 using namespace xrit_unreal;
 
+// count heap allocations, to test that parsing does not allocate more than needed for the parsed data
+// other tests in the binary allocate from multiple threads, so the counter is atomic
+namespace
+{
+    std::atomic<size_t> allocationCount = 0;
+}
+
+void* operator new(size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size == 0 ? 1 : size))
+    {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+    std::free(pointer);
+}
+
 namespace xrit_unreal::configuration_tests
 {
     TEST(Configuration, ParseConfiguration)
@@ -17,7 +48,53 @@ namespace xrit_unreal::configuration_tests
 
         // parse configuration
         Configuration configuration;
-        std::vector<ParseError> errors = parse(document.document.get_value().value(), configuration, "");
+        ParseErrors errors = parse(document.document.get_value().value(), configuration, "");
+        ASSERT_TRUE(errors.empty());
+    }
+
+    // parsing valid json should only allocate for the parsed data, so about as often as copying the parsed data. parsing
+    // does not know the size of a vector up front, so a vector allocates again each time it grows beyond its capacity
+    void testParseAllocations(std::string const& json)
+    {
+        JsonDocument document;
+        ASSERT_EQ(parseJson(json, document), simdjson::SUCCESS);
+        simdjson::ondemand::value value = document.document.get_value().value();
+
+        Configuration configuration;
+        size_t before = allocationCount;
+        ParseErrors errors = parse(value, configuration, "");
+        size_t parseAllocationCount = allocationCount - before;
         ASSERT_TRUE(errors.empty());
+
+        before = allocationCount;
+        Configuration copy = configuration;
+        size_t copyAllocationCount = allocationCount - before;
+
+        ASSERT_GE(parseAllocationCount, copyAllocationCount);
+        ASSERT_LE(parseAllocationCount, 2 * copyAllocationCount);
+    }
+
+    TEST(Configuration, ParseConfigurationAllocations)
+    {
+        testParseAllocations(generateMockConfiguration());
+        testParseAllocations(generateLargeMockConfiguration(1000));
+    }
+
+    TEST(Configuration, ParserPoolAllocations)
+    {
+        std::string mockConfiguration = generateMockConfiguration();
+        JsonParserPool pool;
+        {
+            PooledJsonDocument document;
+            ASSERT_EQ(pool.parse(mockConfiguration, document), simdjson::SUCCESS);
+        }
+
+        // the parser and its buffers are reused, so parsing a document of the same size does not allocate
+        size_t before = allocationCount;
+        {
+            PooledJsonDocument document;
+            ASSERT_EQ(pool.parse(mockConfiguration, document), simdjson::SUCCESS);
+        }
+        ASSERT_EQ(allocationCount - before, 0);
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+
+#include <xrit_unreal/data/configuration.h>
+#include <xrit_unreal/generate_mock_data.h>
+#include <xrit_unreal/parse_json.h>
+#include <xrit_unreal/reflect/diff.h>
+
+#include <unordered_map>
+
+using namespace xrit_unreal;
+
+namespace xrit_unreal::diff_tests
+{
+    struct MapClass
+    {
+        std::unordered_map<std::string_view, uint64_t> map;
+        std::vector<int64_t> list;
+    };
+}
+
+REFLECT_IMPL_STRUCT_BEGIN(xrit_unreal::diff_tests::MapClass)
+                    REFLECT_IMPL_FIELD(map)
+                    REFLECT_IMPL_FIELD(list)
+REFLECT_IMPL_STRUCT_END
+
+namespace xrit_unreal::diff_tests
+{
+    template<typename T>
+    std::string toJson(T& value)
+    {
+        return serializeToString(value);
+    }
+
+    // parses the configuration, which references document
+    Configuration parseConfiguration(std::string const& json, JsonDocument& document)
+    {
+        Configuration configuration{};
+        EXPECT_EQ(parseJson(json, document), simdjson::SUCCESS);
+        EXPECT_TRUE(parse(document.document.get_value().value(), configuration, "").empty());
+        return configuration;
+    }
+
+    // applies the diff from before to after to a copy of before, and checks that it is the same as after
+    template<typename T>
+    void assertPatchGives(T const& before, T after, Diff const& diff)
+    {
+        T patched = before;
+        StringArena strings(64);
+        ASSERT_TRUE(patch(patched, diff, strings));
+        ASSERT_EQ(toJson(patched), toJson(after));
+    }
+
+    TEST(Diff, Equal)
+    {
+        JsonDocument document;
+        Configuration configuration = parseConfiguration(generateLargeMockConfiguration(100), document);
+        ASSERT_TRUE(diff(configuration, configuration).empty());
+    }
+
+    TEST(Diff, Field)
+    {
+        JsonDocument document;
+        Configuration before = parseConfiguration(generateLargeMockConfiguration(100), document);
+        Configuration after = before;
+        auto& source = std::get<LiveLinkMvnSource>(after.livelink.sources[8]);
+        source.settings.port = 1234;
+        after.udp_unicast_endpoint.url = "10.0.0.1";
+
+        Diff changes = diff(before, after);
+        ASSERT_EQ(changes.size(), 2);
+        ASSERT_EQ(changes[0].type, DiffOperationType::Replace);
+        ASSERT_EQ(changes[0].path, "/udp_unicast_endpoint/url");
+        ASSERT_EQ(changes[0].value, "\"10.0.0.1\"");
+        ASSERT_EQ(changes[1].type, DiffOperationType::Replace);
+        ASSERT_EQ(changes[1].path, "/livelink/sources/" + serializeGuid(source.id) + "/settings/port");
+        ASSERT_EQ(changes[1].value, "1234");
+        assertPatchGives(before, after, changes);
+    }
+
+    TEST(Diff, KeyedVector)
+    {
+        JsonDocument document;
+        Configuration before = parseConfiguration(generateLargeMockConfiguration(20), document);
+
+        // the order of sources is not a difference
+        Configuration reordered = before;
+        std::reverse(reordered.livelink.sources.begin(), reordered.livelink.sources.end());
+        ASSERT_TRUE(diff(before, reordered).empty());
+
+        // removing and adding sources
+        Configuration after = before;
+        Guid removedId = guidKey(after.livelink.sources[3]);
+        after.livelink.sources.erase(after.livelink.sources.begin() + 3);
+        LiveLinkDummySource added{.id = generateMockGuid(), .settings{.ip_address = "1.2.3.4", .port = 5}};
+        after.livelink.sources.emplace_back(added);
+
+        Diff changes = diff(before, after);
+        ASSERT_EQ(changes.size(), 2);
+        ASSERT_EQ(changes[0].type, DiffOperationType::Add);
+        ASSERT_EQ(changes[0].path, "/livelink/sources/" + serializeGuid(added.id));
+        ASSERT_EQ(changes[1].type, DiffOperationType::Remove);
+        ASSERT_EQ(changes[1].path, "/livelink/sources/" + serializeGuid(removedId));
+        assertPatchGives(before, after, changes);
+    }
+
+    TEST(Diff, Variant)
+    {
+        JsonDocument document;
+        Configuration before = parseConfiguration(generateLargeMockConfiguration(7), document);
+
+        // same id, different source type
+        Configuration after = before;
+        Guid id = guidKey(after.livelink.sources[0]);
+        after.livelink.sources[0] = LiveLinkMvnSource{.id = id};
+
+        Diff changes = diff(before, after);
+        ASSERT_EQ(changes.size(), 1);
+        ASSERT_EQ(changes[0].type, DiffOperationType::Replace);
+        ASSERT_EQ(changes[0].path, "/livelink/sources/" + serializeGuid(id));
+        assertPatchGives(before, after, changes);
+    }
+
+    TEST(Diff, VectorAndMap)
+    {
+        MapClass before{.map{{"a", 1}, {"b/c~", 2}}, .list{1, 2, 3}};
+
+        MapClass after = before;
+        after.map["b/c~"] = 3;
+        after.map.erase("a");
+        after.map["d"] = 4;
+        after.list = {1, 5};
+
+        Diff changes = diff(before, after);
+        std::unordered_map<std::string, DiffOperation> byPath;
+        for (DiffOperation const& change: changes)
+        {
+            byPath[change.path] = change;
+        }
+        ASSERT_EQ(changes.size(), 5);
+        ASSERT_EQ(byPath["/map/b~1c~0"].type, DiffOperationType::Replace);
+        ASSERT_EQ(byPath["/map/b~1c~0"].value, "3");
+        ASSERT_EQ(byPath["/map/d"].type, DiffOperationType::Add);
+        ASSERT_EQ(byPath["/map/a"].type, DiffOperationType::Remove);
+        ASSERT_EQ(byPath["/list/1"].type, DiffOperationType::Replace);
+        ASSERT_EQ(byPath["/list/2"].type, DiffOperationType::Remove);
+
+        MapClass patched = before;
+        StringArena strings(64);
+        ASSERT_TRUE(patch(patched, changes, strings));
+        ASSERT_EQ(patched.map, after.map);
+        ASSERT_EQ(patched.list, after.list);
+
+        // growing a vector adds entries at the end
+        ASSERT_TRUE(patch(patched, diff(after, before), strings));
+        ASSERT_EQ(patched.map, before.map);
+        ASSERT_EQ(patched.list, before.list);
+    }
+
+    TEST(Diff, InvalidPatch)
+    {
+        MapClass value{.map{{"a", 1}}, .list{1}};
+        StringArena strings(64);
+        ASSERT_FALSE(patch(value, {{DiffOperationType::Replace, "/unknown", "1"}}, strings));
+        ASSERT_FALSE(patch(value, {{DiffOperationType::Replace, "/map/b", "1"}}, strings));
+        ASSERT_FALSE(patch(value, {{DiffOperationType::Remove, "/list/1", ""}}, strings));
+        ASSERT_FALSE(patch(value, {{DiffOperationType::Replace, "/list/0", "\"text\""}}, strings));
+        ASSERT_FALSE(patch(value, {{DiffOperationType::Remove, "/list", ""}}, strings)); // fields can't be removed
+        ASSERT_FALSE(patch(value, {{DiffOperationType::Replace, "/list/0/more", "1"}}, strings));
+        ASSERT_EQ(value.map.at("a"), 1);
+        ASSERT_EQ(value.list, std::vector<int64_t>{1});
+    }
+}
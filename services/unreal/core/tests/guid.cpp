@@ -7,9 +7,67 @@
 #include <xrit_unreal/parse_json.h>
 #include <xrit_unreal/guid.h>
 #include <xrit_unreal/reflect/parse.h>
+#include <xrit_unreal/reflect/serialize.h>
+
+#include <cctype>
+#include <iomanip>
+#include <random>
+#include <sstream>
 
 namespace xrit_unreal::guid_tests
 {
+    // the implementations before the table driven ones, to compare against
+
+    std::string referenceSerializeGuid(Guid const& guid)
+    {
+        std::ostringstream stream;
+        for (uint32_t value: {guid.a, guid.b, guid.c, guid.d})
+        {
+            stream << std::setw(8) << std::setfill('0') << std::hex << value;
+        }
+        std::string string = stream.str();
+        return string.substr(0, 8) + "-" + string.substr(8, 4) + "-" + string.substr(12, 4) + "-" +
+               string.substr(16, 4) + "-" + string.substr(20, 12);
+    }
+
+    std::string_view referenceTryParseGuid(std::string_view value, Guid& outGuid)
+    {
+        if (value.length() != 36)
+        {
+            return "guid string should have length 36";
+        }
+        if (value[8] != '-' || value[13] != '-' || value[18] != '-' || value[23] != '-')
+        {
+            return "guid hyphen placement is incorrect, expected: 00000000-0000-0000-0000-000000000000";
+        }
+        std::string withoutHyphens = std::string(value.substr(0, 8)) + std::string(value.substr(9, 4)) +
+                                     std::string(value.substr(14, 4)) + std::string(value.substr(19, 4)) +
+                                     std::string(value.substr(24, 12));
+        for (char character: withoutHyphens)
+        {
+            if (!std::isxdigit(static_cast<unsigned char>(character)))
+            {
+                return "guid characters should be valid hex characters";
+            }
+        }
+        uint32_t words[4];
+        for (size_t i = 0; i < 4; i++)
+        {
+            words[i] = static_cast<uint32_t>(std::stoul(withoutHyphens.substr(i * 8, 8), nullptr, 16));
+        }
+        outGuid = {words[0], words[1], words[2], words[3]};
+        return {};
+    }
+
+    // parses string with both implementations, and checks that they give the same result and error
+    void assertParseSameAsReference(std::string_view string)
+    {
+        Guid result{1, 2, 3, 4};
+        Guid expected{1, 2, 3, 4};
+        ASSERT_EQ(tryParseGuid(string, result), referenceTryParseGuid(string, expected)) << string;
+        ASSERT_EQ(result, expected) << string;
+    }
+
     TEST(Guid, IsHexCharacter)
     {
         std::string validCharacters = "abcdefABCDEF0123456789";
@@ -136,4 +194,93 @@ namespace xrit_unreal::guid_tests
 
         ASSERT_EQ(result, expected);
     }
-}
\ No newline at end of file
+
+    TEST(Guid, FormatGuid)
+    {
+        // written into the middle of a buffer, without touching the bytes around it
+        std::string buffer(40, '#');
+        formatGuid(Guid{3735056907, 3680977288, 2330788359, 165672687}, buffer.data() + 2);
+        ASSERT_EQ(buffer, "##dea0720b-db67-4188-8aed-020709dff6ef##");
+
+        JsonWriter out;
+        serialize(Guid{0, 0, 0, 0}, out);
+        ASSERT_EQ(out.view(), R"("00000000-0000-0000-0000-000000000000")");
+    }
+
+    TEST(Guid, SameAsReference)
+    {
+        // every byte value in every byte of the guid, and random guids
+        std::vector<Guid> guids;
+        for (uint32_t byte = 0; byte < 256; byte++)
+        {
+            for (uint32_t shift = 0; shift < 32; shift += 8)
+            {
+                guids.push_back({byte << shift, 0, 0, 0});
+                guids.push_back({0, byte << shift, 0, 0});
+                guids.push_back({0, 0, byte << shift, 0});
+                guids.push_back({0, 0, 0, byte << shift});
+            }
+        }
+        guids.push_back({0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF});
+        std::mt19937 random(50);
+        for (size_t i = 0; i < 10000; i++)
+        {
+            guids.push_back({static_cast<uint32_t>(random()), static_cast<uint32_t>(random()),
+                             static_cast<uint32_t>(random()), static_cast<uint32_t>(random())});
+        }
+
+        for (Guid const& guid: guids)
+        {
+            std::string string = serializeGuid(guid);
+            ASSERT_EQ(string, referenceSerializeGuid(guid));
+            assertParseSameAsReference(string);
+
+            // uppercase parses to the same guid
+            std::string uppercase = string;
+            for (char& character: uppercase)
+            {
+                character = static_cast<char>(std::toupper(static_cast<unsigned char>(character)));
+            }
+            Guid parsed{};
+            ASSERT_TRUE(tryParseGuid(uppercase, parsed).empty());
+            ASSERT_EQ(parsed, guid);
+        }
+    }
+
+    TEST(Guid, ParseSameAsReference)
+    {
+        // every character at every position of a valid guid
+        std::string const valid = "7FD45F44-f4be-4B62-969a-8D6EDB85711D";
+        for (size_t position = 0; position < valid.size(); position++)
+        {
+            for (int character = 0; character < 256; character++)
+            {
+                std::string string = valid;
+                string[position] = static_cast<char>(character);
+                assertParseSameAsReference(string);
+            }
+        }
+
+        // every length
+        for (size_t length = 0; length < 40; length++)
+        {
+            assertParseSameAsReference(std::string(length, 'a'));
+            assertParseSameAsReference((valid + valid).substr(0, length));
+        }
+
+        // every character for the single character functions
+        for (int character = 0; character < 256; character++)
+        {
+            char c = static_cast<char>(character);
+            ASSERT_EQ(isHexCharacter(c), std::isxdigit(character) != 0) << character;
+            if (isHexCharacter(c))
+            {
+                ASSERT_EQ(parseHexCharacter(c), std::stoul(std::string(1, c), nullptr, 16));
+            }
+            else
+            {
+                ASSERT_EQ(parseHexCharacter(c), 0);
+            }
+        }
+    }
+}
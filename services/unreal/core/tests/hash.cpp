@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+
+#include <xrit_unreal/data/livelink.h>
+#include <xrit_unreal/reflect/hash.h>
+
+#include <unordered_map>
+
+using namespace xrit_unreal;
+
+namespace xrit_unreal::hash_tests
+{
+    // calls onLeaf for each value in value that is not a reflected class (recursively), with whether it is inside a
+    // field marked with REFLECT_MUTABLE
+    template<typename T, typename OnLeaf>
+    void forEachLeaf(T& value, bool isMutable, OnLeaf& onLeaf)
+    {
+        if constexpr (IsClass<T>::value && !std::is_same_v<T, std::string_view> && !std::is_same_v<T, Guid>)
+        {
+            std::apply([&](auto&&... fields) {
+                (forEachLeaf(value.*fields.value, isMutable || fields.isMutable, onLeaf), ...);
+            }, classInfo<T>().fields);
+        }
+        else
+        {
+            onLeaf(value, isMutable);
+        }
+    }
+
+    template<typename T>
+    void change(T& value)
+    {
+        if constexpr (std::is_same_v<T, bool>)
+        {
+            value = !value;
+        }
+        else if constexpr (std::is_enum_v<T>)
+        {
+            value = static_cast<T>(static_cast<int>(value) == 1 ? 2 : 1);
+        }
+        else if constexpr (std::is_same_v<T, std::string_view>)
+        {
+            value = value == "changed" ? "other" : "changed";
+        }
+        else if constexpr (std::is_same_v<T, Guid>)
+        {
+            value.d++;
+        }
+        else
+        {
+            value += 1;
+        }
+    }
+
+    // changes each leaf of T one by one, and checks that this changes the hash, unless it is a mutable field
+    // returns the number of leaves
+    template<typename T>
+    size_t assertEveryFieldAffectsHash()
+    {
+        T original{};
+        uint64_t originalHash = hashValue(original);
+
+        size_t leafCount = 0;
+        auto countLeaves = [&](auto&, bool) { leafCount++; };
+        forEachLeaf(original, false, countLeaves);
+
+        for (size_t changedLeaf = 0; changedLeaf < leafCount; changedLeaf++)
+        {
+            T changed = original;
+            size_t leaf = 0;
+            bool isMutableLeaf = false;
+            auto changeLeaf = [&](auto& value, bool isMutable) {
+                if (leaf++ == changedLeaf)
+                {
+                    change(value);
+                    isMutableLeaf = isMutable;
+                }
+            };
+            forEachLeaf(changed, false, changeLeaf);
+
+            if (isMutableLeaf)
+            {
+                EXPECT_EQ(hashValue(changed), originalHash) << typeName<T>() << " leaf " << changedLeaf;
+            }
+            else
+            {
+                EXPECT_NE(hashValue(changed), originalHash) << typeName<T>() << " leaf " << changedLeaf;
+            }
+        }
+        return leafCount;
+    }
+
+    TEST(Hash, EveryFieldAffectsSettingsHash)
+    {
+        // all settings of the live link sources, base is mutable
+        ASSERT_EQ(assertEveryFieldAffectsHash<LiveLinkDummySourceSettings>(), 2 + 14);
+        ASSERT_EQ(assertEveryFieldAffectsHash<LiveLinkMvnSourceSettings>(), 1 + 14);
+        ASSERT_EQ(assertEveryFieldAffectsHash<LiveLinkOptitrackSourceSettings>(), 3 + 14);
+        ASSERT_EQ(assertEveryFieldAffectsHash<LiveLinkXrSourceSettings>(), 4 + 14);
+        ASSERT_EQ(assertEveryFieldAffectsHash<VirtualSubjectSourceSettings>(), 0);
+        ASSERT_EQ(assertEveryFieldAffectsHash<LiveLinkFreeDSourceSettings>(), 2 + 14 + 2 + 3 * 6);
+        ASSERT_EQ(assertEveryFieldAffectsHash<LiveLinkMessageBusSourceSettings>(), 3 + 14);
+    }
+
+    TEST(Hash, Containers)
+    {
+        // the order of vectors is part of the hash
+        ASSERT_NE(hashValue(std::vector<uint64_t>{1, 2}, 0), hashValue(std::vector<uint64_t>{2, 1}, 0));
+        ASSERT_NE(hashValue(std::vector<std::vector<uint64_t>>{{1}, {}}, 0),
+                  hashValue(std::vector<std::vector<uint64_t>>{{}, {1}}, 0));
+
+        // the order of unordered maps is not
+        std::vector<std::string> keys;
+        for (uint64_t i = 0; i < 100; i++)
+        {
+            keys.emplace_back(std::to_string(i));
+        }
+        std::unordered_map<std::string_view, uint64_t> map;
+        for (uint64_t i = 0; i < keys.size(); i++)
+        {
+            map[keys[i]] = i;
+        }
+        std::unordered_map<std::string_view, uint64_t> rehashed(map.begin(), map.end(), 1000);
+        ASSERT_EQ(hashValue(map, 0), hashValue(rehashed, 0));
+        rehashed["1"] = 2;
+        ASSERT_NE(hashValue(map, 0), hashValue(rehashed, 0));
+
+        // same settings, different source type
+        LiveLinkSourceVariants dummy = LiveLinkDummySource{};
+        LiveLinkSourceVariants mvn = LiveLinkMvnSource{};
+        ASSERT_NE(hashValue(dummy, 0), hashValue(mvn, 0));
+    }
+
+    TEST(Hash, Strings)
+    {
+        // strings are hashed 8 bytes at a time, the zero padding of the last bytes is not the same as zeros
+        ASSERT_NE(hashValue(std::string_view("abc"), 0), hashValue(std::string_view("abc\0", 4), 0));
+        ASSERT_NE(hashValue(std::string_view("01234567"), 0), hashValue(std::string_view("012345678"), 0));
+        ASSERT_EQ(hashValue(std::string_view("0123456789"), 0), hashValue(std::string_view("0123456789"), 0));
+        ASSERT_NE(hashValue(std::string_view(""), 0), hashValue(std::string_view(""), 1));
+    }
+}
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+
+#include <xrit_unreal/data/configuration.h>
+#include <xrit_unreal/generate_mock_data.h>
+#include <xrit_unreal/json_format.h>
+#include <xrit_unreal/parse_json.h>
+#include <xrit_unreal/reflect/parse.h>
+#include <xrit_unreal/reflect/serialize.h>
+
+#include <random>
+
+namespace xrit_unreal::json_format_tests
+{
+    TEST(JsonFormat, Prettify)
+    {
+        std::string json = R"({"a":1,"b":[true,null,"c"],"d":{"e":-1.5e3}})";
+        ASSERT_EQ(prettifyJson(json), R"({
+    "a": 1,
+    "b": [
+        true,
+        null,
+        "c"
+    ],
+    "d": {
+        "e": -1.5e3
+    }
+})");
+        ASSERT_EQ(prettifyJson(json, 1, '\t'), "{\n\t\"a\": 1,\n\t\"b\": [\n\t\ttrue,\n\t\tnull,\n\t\t\"c\"\n\t],\n\t\"d\": "
+                                               "{\n\t\t\"e\": -1.5e3\n\t}\n}");
+
+        // existing whitespace is replaced
+        ASSERT_EQ(prettifyJson(" {\r\n\t\"a\" :  [ 1 ,2 ]\n}\n", 2), "{\n  \"a\": [\n    1,\n    2\n  ]\n}");
+
+        // empty objects and arrays stay on one line
+        ASSERT_EQ(prettifyJson(R"({"a":{},"b":[ ],"c":[{}]})", 1), "{\n \"a\": {},\n \"b\": [],\n \"c\": [\n  {}\n ]\n}");
+        ASSERT_EQ(prettifyJson(""), "");
+        ASSERT_EQ(prettifyJson("12"), "12");
+    }
+
+    TEST(JsonFormat, Minify)
+    {
+        ASSERT_EQ(minifyJson(" {\r\n\t\"a\" :  [ 1 ,2, \"x y\" ]\n}\n"), R"({"a":[1,2,"x y"]})");
+        ASSERT_EQ(minifyJson(""), "");
+        ASSERT_EQ(minifyJson("   "), "");
+    }
+
+    TEST(JsonFormat, Strings)
+    {
+        // structural characters, whitespace and escaped quotes inside strings are not changed
+        std::string json = R"({"a\"b, :{}[]":"c\\","d":"\\\" ,x","e":"\" }"})";
+        ASSERT_EQ(prettifyJson(json), R"({
+    "a\"b, :{}[]": "c\\",
+    "d": "\\\" ,x",
+    "e": "\" }"
+})");
+        ASSERT_EQ(minifyJson(prettifyJson(json)), json);
+
+        // nothing is read after the end of the view, which is not null terminated
+        std::string buffer = R"(["a"]"," ])";
+        ASSERT_EQ(minifyJson(std::string_view(buffer).substr(0, 5)), R"(["a"])");
+        ASSERT_EQ(prettifyJson(std::string_view(buffer).substr(0, 3), 1), R"([
+ "a)");
+    }
+
+    TEST(JsonFormat, BlockBoundaries)
+    {
+        // escapes, quotes and structural characters at every position around the 64 byte blocks
+        for (size_t offset = 0; offset < 200; offset++)
+        {
+            for (std::string_view inner: {R"(\")", R"(\\)", R"(\\\")", R"(", ")", R"( , )"})
+            {
+                std::string json = "[\"" + std::string(offset, 'a') + std::string(inner) + "\", 1]";
+                std::string pretty = prettifyJson(json, 1);
+                ASSERT_EQ(minifyJson(pretty), minifyJson(json)) << json;
+
+                JsonDocument document;
+                std::vector<std::string_view> before;
+                std::vector<std::string_view> after;
+                if (parseJson(json, document) == simdjson::SUCCESS &&
+                    parse(document.document.get_value().value(), before, "").empty())
+                {
+                    // valid json is still the same json after formatting
+                    JsonDocument prettyDocument;
+                    ASSERT_EQ(parseJson(pretty, prettyDocument), simdjson::SUCCESS) << pretty;
+                    ASSERT_TRUE(parse(prettyDocument.document.get_value().value(), after, "").empty()) << pretty;
+                    ASSERT_EQ(after, before);
+                }
+            }
+        }
+    }
+
+    TEST(JsonFormat, RoundTrip)
+    {
+        JsonDocument document;
+        ASSERT_EQ(parseJson(generateLargeMockConfiguration(100), document), simdjson::SUCCESS);
+        Configuration configuration{};
+        ASSERT_TRUE(parse(document.document.get_value().value(), configuration, "").empty());
+        std::string json = serializeToString(configuration);
+
+        std::string pretty = prettifyJson(json);
+        ASSERT_GT(pretty.size(), json.size());
+        ASSERT_EQ(minifyJson(pretty), json);
+        ASSERT_EQ(prettifyJson(pretty), pretty);
+
+        // random strings with many characters that have to be escaped
+        std::mt19937 random(48);
+        std::vector<std::string_view> const pieces{"a", " ", "\"", "\\", "{", "]", ",", ":", "\n", "\xc3\xa9"};
+        std::uniform_int_distribution<size_t> piece(0, pieces.size() - 1);
+        std::uniform_int_distribution<size_t> length(0, 100);
+        for (int iteration = 0; iteration < 100; iteration++)
+        {
+            std::vector<std::string> strings(10);
+            for (std::string& string: strings)
+            {
+                for (size_t i = length(random); i > 0; i--)
+                {
+                    string += pieces[piece(random)];
+                }
+            }
+            std::vector<std::string_view> values(strings.begin(), strings.end());
+            std::string serialized = serializeToString(values);
+            ASSERT_EQ(minifyJson(prettifyJson(serialized)), serialized);
+        }
+    }
+}
@@ -2,6 +2,7 @@
 
 #include <xrit_unreal/livelink.h>
 #include <xrit_unreal/generate_mock_data.h>
+#include <xrit_unreal/status.h>
 
 #include <unordered_map>
 
@@ -99,4 +100,169 @@ namespace xrit_unreal::livelink_tests
         assertExists(mockUnreal, cache, id1, true);
         assertExists(mockUnreal, cache, id2, false);
     }
+
+    TEST(LiveLink, CacheKeepsStrings)
+    {
+        LiveLinkSourceCache cache{};
+        LiveLinkCallbacks callbacks{
+            .removeSource = [](Guid) -> std::vector<LiveLinkError> { return {}; },
+            .createSource = [](LiveLinkSourceVariants const&, Guid& outUnrealId) -> std::vector<LiveLinkError> {
+                outUnrealId = generateMockGuid();
+                return {};
+            },
+            .updateSource = [](LiveLinkSourceVariants const&, Guid) -> std::vector<LiveLinkError> { return {}; }
+        };
+
+        // the strings of the sources are owned by the arena, as if they were parsed with it
+        Guid id = generateMockGuid();
+        auto strings = std::make_shared<StringArena>(16);
+        std::vector<LiveLinkSourceVariants> desiredSources{
+            LiveLinkDummySource{
+                .id = id,
+                .settings{
+                    .ip_address = strings->store(std::string("127.0.0.1")),
+                    .port = 1
+                }
+            }
+        };
+        ASSERT_TRUE(setLiveLinkSources(cache, desiredSources, callbacks, strings).empty());
+
+        // the cache entry keeps the arena alive after the configuration is gone
+        desiredSources.clear();
+        std::weak_ptr<StringArena const> weakStrings = strings;
+        strings.reset();
+        ASSERT_FALSE(weakStrings.expired());
+        LiveLinkSourceCacheEntry const& entry = cache.entries.at(id);
+        ASSERT_EQ(std::get<LiveLinkDummySource>(entry.value).settings.ip_address, "127.0.0.1");
+
+        // removing the source releases the arena
+        ASSERT_TRUE(setLiveLinkSources(cache, desiredSources, callbacks).empty());
+        ASSERT_TRUE(weakStrings.expired());
+    }
+
+    TEST(LiveLink, RecreateOnSettingsChange)
+    {
+        LiveLinkSourceCache cache{};
+        size_t createCount = 0;
+        size_t updateCount = 0;
+        LiveLinkCallbacks callbacks{
+            .removeSource = [](Guid) -> std::vector<LiveLinkError> { return {}; },
+            .createSource = [&](LiveLinkSourceVariants const&, Guid& outUnrealId) -> std::vector<LiveLinkError> {
+                createCount++;
+                outUnrealId = generateMockGuid();
+                return {};
+            },
+            .updateSource = [&](LiveLinkSourceVariants const&, Guid) -> std::vector<LiveLinkError> {
+                updateCount++;
+                return {};
+            }
+        };
+
+        LiveLinkXrSource source{.id = generateMockGuid()};
+        std::vector<LiveLinkSourceVariants> desiredSources{source};
+        ASSERT_TRUE(setLiveLinkSources(cache, desiredSources, callbacks).empty());
+        ASSERT_EQ(createCount, 1);
+
+        // the base settings can be updated
+        source.settings.base.mode = LiveLinkSourceMode::Latest;
+        desiredSources = {source};
+        ASSERT_TRUE(setLiveLinkSources(cache, desiredSources, callbacks).empty());
+        ASSERT_EQ(createCount, 1);
+        ASSERT_EQ(updateCount, 1);
+
+        // other settings require recreating the source
+        source.settings.track_hmds = !source.settings.track_hmds;
+        desiredSources = {source};
+        ASSERT_TRUE(setLiveLinkSources(cache, desiredSources, callbacks).empty());
+        ASSERT_EQ(createCount, 2);
+        ASSERT_EQ(updateCount, 1);
+
+        // and so does changing the type of the source
+        desiredSources = {LiveLinkMvnSource{.id = source.id}};
+        ASSERT_TRUE(setLiveLinkSources(cache, desiredSources, callbacks).empty());
+        ASSERT_EQ(createCount, 3);
+    }
+
+    TEST(LiveLink, SkipUnchangedSources)
+    {
+        LiveLinkSourceCache cache{};
+        size_t updateCount = 0;
+        std::vector<LiveLinkError> removeErrors;
+        LiveLinkCallbacks callbacks{
+            .removeSource = [&](Guid) -> std::vector<LiveLinkError> { return removeErrors; },
+            .createSource = [](LiveLinkSourceVariants const&, Guid& outUnrealId) -> std::vector<LiveLinkError> {
+                outUnrealId = generateMockGuid();
+                return {};
+            },
+            .updateSource = [&](LiveLinkSourceVariants const&, Guid) -> std::vector<LiveLinkError> {
+                updateCount++;
+                return {};
+            }
+        };
+
+        LiveLinkMvnSource first{.id = generateMockGuid(), .settings{.port = 1}};
+        LiveLinkMvnSource second{.id = generateMockGuid(), .settings{.port = 2}};
+        std::vector<LiveLinkSourceVariants> desiredSources{first, second};
+        LiveLinkSourceChanges changes;
+        ASSERT_TRUE(setLiveLinkSources(cache, desiredSources, callbacks, nullptr, &changes).empty());
+        ASSERT_EQ(changes.created, 2);
+        ASSERT_EQ(changes.unchanged, 0);
+
+        // setting the same sources again does not update them
+        ASSERT_TRUE(setLiveLinkSources(cache, desiredSources, callbacks, nullptr, &changes).empty());
+        ASSERT_EQ(updateCount, 0);
+        ASSERT_EQ(changes.created, 0);
+        ASSERT_EQ(changes.updated, 0);
+        ASSERT_EQ(changes.unchanged, 2);
+
+        // only the source with changed base settings is updated, and the removed source is counted
+        second.settings.base.buffer_settings.latest_offset = 5;
+        desiredSources = {second};
+        ASSERT_TRUE(setLiveLinkSources(cache, desiredSources, callbacks, nullptr, &changes).empty());
+        ASSERT_EQ(updateCount, 1);
+        ASSERT_EQ(changes.updated, 1);
+        ASSERT_EQ(changes.unchanged, 0);
+        ASSERT_EQ(changes.removed, 1);
+        ASSERT_EQ(std::get<LiveLinkMvnSource>(cache.entries.at(second.id).value).settings.base.buffer_settings
+                      .latest_offset, 5);
+
+        // a source that failed to be removed is not counted
+        removeErrors = {LiveLinkError{LiveLinkErrorCode::SourceDoesNotExist, second.id}};
+        desiredSources.clear();
+        ASSERT_EQ(setLiveLinkSources(cache, desiredSources, callbacks, nullptr, &changes).size(), 1);
+        ASSERT_EQ(changes.removed, 0);
+    }
+
+    TEST(LiveLink, StatusView)
+    {
+        LiveLinkSourceCache cache{};
+        LiveLinkCallbacks callbacks{
+            .removeSource = [](Guid) -> std::vector<LiveLinkError> { return {}; },
+            .createSource = [](LiveLinkSourceVariants const&, Guid& outUnrealId) -> std::vector<LiveLinkError> {
+                outUnrealId = generateMockGuid();
+                return {};
+            },
+            .updateSource = [](LiveLinkSourceVariants const&, Guid) -> std::vector<LiveLinkError> { return {}; }
+        };
+        std::vector<LiveLinkSourceVariants> desiredSources{
+            LiveLinkMvnSource{.id = generateMockGuid(), .settings{.port = 1}},
+            LiveLinkDummySource{.id = generateMockGuid(), .settings{.ip_address = "a \"quoted\" address"}},
+            LiveLinkXrSource{.id = generateMockGuid(), .subjects{1, 2}}
+        };
+        ASSERT_TRUE(setLiveLinkSources(cache, desiredSources, callbacks).empty());
+
+        // the view serializes to the same json as a configuration with copies of the sources
+        Configuration status{};
+        for (auto const& entry: cache.entries)
+        {
+            status.livelink.sources.emplace_back(entry.second.value);
+        }
+        StatusView view{.livelink{.sources{cache.entries}}};
+        ASSERT_EQ(serializeToString(view), serializeToString(status));
+        ASSERT_EQ(serializedSize(view), serializeToString(view).size());
+
+        LiveLinkSourceCache empty{};
+        StatusView emptyView{.livelink{.sources{empty.entries}}};
+        ASSERT_EQ(serializeToString(emptyView), serializeToString(Configuration{}));
+    }
 }
@@ -10,7 +10,7 @@ using namespace xrit_unreal;
 class MockUnrealService final : public IWebSocketListener
 {
 public:
-    explicit MockUnrealService(WebSocket* webSocket_) : webSocket(webSocket_)
+    explicit MockUnrealService(WebSocket* webSocket_, Capabilities capabilities_) : webSocket(webSocket_), capabilities(capabilities_)
     {
 
     }
@@ -21,7 +21,7 @@ public:
     void onConnected(WebSocket* caller) override
     {
         std::cout << "mock unreal service: onConnected" << std::endl;
-        caller->sendMessage(createNodeMessage(NodeCommand::initialized, ""));
+        caller->sendMessage(createNodeMessage(NodeCommand::initialized, serializeCapabilities(capabilities)));
     }
 
     void onDisconnected(WebSocket* caller) override
@@ -29,7 +29,7 @@ public:
         std::cout << "mock unreal service: onDisconnected" << std::endl;
     }
 
-    void onMessage(WebSocket* caller, std::string message) override
+    void onMessage(WebSocket* caller, simdjson::padded_string_view message) override
     {
         std::cout << "mock unreal service: onMessage: " << message << std::endl;
         MessageData data;
@@ -56,6 +56,16 @@ public:
                 caller->sendMessage(createNodeMessage(NodeCommand::status, generateMockStatus()));
                 break;
             }
+            case UnrealCommand::capabilities:
+            {
+                Capabilities nodeCapabilities;
+                bool parsed = parseCapabilities(unrealMessage.data, nodeCapabilities);
+                assert(parsed);
+                (void)parsed;
+                negotiatedCapabilities = negotiateCapabilities(capabilities, nodeCapabilities);
+                std::cout << "mock unreal service: negotiated capabilities: " << serializeCapabilities(negotiatedCapabilities) << std::endl;
+                break;
+            }
             default:
                 assert(false);
         }
@@ -63,6 +73,8 @@ public:
 
 private:
     WebSocket* webSocket;
+    Capabilities capabilities; // capabilities of this mock unreal service
+    Capabilities negotiatedCapabilities{}; // plain text protocol until the node replies with its capabilities
 };
 
 int main(int argc, char const** argv)
@@ -73,8 +85,17 @@ int main(int argc, char const** argv)
         .maxBytesPerFrame = 1024,
         .server = false,
     };
+    // optionally provide the capabilities to advertise as json, to test negotiation with the mock xrit node, e.g.
+    // mock_unreal_service "{\"compression\": true, \"heartbeat_interval_ms\": 1000}"
+    Capabilities capabilities = supportedCapabilities();
+    if (argc > 1 && !parseCapabilities(argv[1], capabilities))
+    {
+        std::cout << "invalid capabilities: " << argv[1] << std::endl;
+        return 1;
+    }
+
     WebSocket webSocket(config);
-    MockUnrealService service(&webSocket);
+    MockUnrealService service(&webSocket, capabilities);
     webSocket.listener = &service;
     webSocket.run();
 
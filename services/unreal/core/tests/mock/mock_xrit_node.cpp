@@ -1,6 +1,7 @@
 #include <xrit_unreal/websocket.h>
 #include <xrit_unreal/communication_protocol.h>
 #include <xrit_unreal/generate_mock_data.h>
+#include <xrit_unreal/json_format.h>
 
 using namespace xrit_unreal;
 
@@ -12,7 +13,7 @@ namespace mock_xrit_node
     class MockXritNode final : public IWebSocketListener
     {
     public:
-        explicit MockXritNode(WebSocket* webSocket_) : webSocket(webSocket_)
+        explicit MockXritNode(WebSocket* webSocket_, Capabilities capabilities_) : webSocket(webSocket_), capabilities(capabilities_)
         {
 
         }
@@ -30,7 +31,7 @@ namespace mock_xrit_node
             std::cout << "mock xrit node: onDisconnected" << std::endl;
         }
 
-        void onMessage(WebSocket* caller, std::string message) override
+        void onMessage(WebSocket* caller, simdjson::padded_string_view message) override
         {
             std::cout << "mock xrit node: onMessage: " << message << std::endl;
 
@@ -43,6 +44,20 @@ namespace mock_xrit_node
             {
                 case NodeCommand::initialized:
                 {
+                    // an older unreal service sends no capabilities, which results in the plain text protocol
+                    Capabilities unrealCapabilities;
+                    bool parsed = parseCapabilities(nodeMessage.data, unrealCapabilities);
+                    assert(parsed);
+                    (void)parsed;
+                    negotiatedCapabilities = negotiateCapabilities(capabilities, unrealCapabilities);
+                    std::cout << "mock xrit node: negotiated capabilities: " << serializeCapabilities(negotiatedCapabilities) << std::endl;
+
+                    // only reply with the capabilities of the node to a peer that knows the capabilities command
+                    if (!nodeMessage.data.empty())
+                    {
+                        caller->sendMessage(createMockUnrealMessage(UnrealCommand::capabilities, serializeCapabilities(capabilities)));
+                    }
+
                     // immediately set config when the unreal service is initialized
                     caller->sendMessage(createMockUnrealMessage(UnrealCommand::set_configuration, generateMockConfiguration()));
 
@@ -69,6 +84,8 @@ namespace mock_xrit_node
 
     private:
         WebSocket* webSocket;
+        Capabilities capabilities; // capabilities of this mock xrit node
+        Capabilities negotiatedCapabilities{};
     };
 }
 
@@ -80,8 +97,17 @@ int main(int argc, char const** argv)
         .maxBytesPerFrame = 1024,
         .server = true
     };
+    // optionally provide the capabilities to advertise as json, to test negotiation with the mock unreal service, e.g.
+    // mock_xrit_node "{\"batching\": true}"
+    Capabilities capabilities = supportedCapabilities();
+    if (argc > 1 && !parseCapabilities(argv[1], capabilities))
+    {
+        std::cout << "invalid capabilities: " << argv[1] << std::endl;
+        return 1;
+    }
+
     WebSocket webSocket(config);
-    mock_xrit_node::MockXritNode node(&webSocket);
+    mock_xrit_node::MockXritNode node(&webSocket, capabilities);
     webSocket.listener = &node;
     webSocket.run();
     return 0;
@@ -2,6 +2,9 @@
 
 #include <xrit_unreal/parse_json.h>
 
+#include <thread>
+#include <vector>
+
 namespace xrit_unreal::parse_json_tests
 {
     TEST(ParseJson, JsonParseDocument)
@@ -22,4 +25,93 @@ namespace xrit_unreal::parse_json_tests
         ASSERT_EQ(error, simdjson::error_code::SUCCESS);
         ASSERT_EQ(str, "this is a string");
     }
-}
\ No newline at end of file
+
+    TEST(ParseJson, ParserPoolReusesParsers)
+    {
+        JsonParserPool pool;
+        {
+            PooledJsonDocument document;
+            ASSERT_EQ(pool.parse(R"({"value": 1})", document), simdjson::SUCCESS);
+            ASSERT_EQ(document.document["value"].get_uint64().value(), 1);
+            ASSERT_EQ(pool.size(), 0);
+        }
+        ASSERT_EQ(pool.size(), 1);
+
+        // parsing into a document that holds a parser gives that parser back first
+        PooledJsonDocument document;
+        ASSERT_EQ(pool.parse(R"({"value": 2})", document), simdjson::SUCCESS);
+        ASSERT_EQ(pool.size(), 0);
+        ASSERT_EQ(pool.parse(R"({"value": 3})", document), simdjson::SUCCESS);
+        ASSERT_EQ(pool.size(), 0);
+        ASSERT_EQ(document.document["value"].get_uint64().value(), 3);
+
+        // moving keeps the document valid
+        PooledJsonDocument moved = std::move(document);
+        moved.document.rewind();
+        ASSERT_EQ(moved.document["value"].get_uint64().value(), 3);
+    }
+
+    TEST(ParseJson, ParserPoolParseMany)
+    {
+        JsonParserPool pool;
+        std::string json = R"({"value": 1} {"value": 2})";
+        {
+            PooledJsonDocumentStream stream;
+            ASSERT_EQ(pool.parseMany(padString(json), simdjson::dom::DEFAULT_BATCH_SIZE, stream), simdjson::SUCCESS);
+            std::vector<uint64_t> values;
+            for (auto document: stream.stream)
+            {
+                values.emplace_back(document["value"].get_uint64().value());
+            }
+            ASSERT_EQ(values, std::vector<uint64_t>({1, 2}));
+            ASSERT_EQ(pool.size(), 0);
+        }
+        ASSERT_EQ(pool.size(), 1);
+
+        // the parser is reused for the next stream
+        PooledJsonDocumentStream stream;
+        ASSERT_EQ(pool.parseMany(padString(json), simdjson::dom::DEFAULT_BATCH_SIZE, stream), simdjson::SUCCESS);
+        ASSERT_EQ(pool.size(), 0);
+    }
+
+    TEST(ParseJson, ParserPoolMaxCapacity)
+    {
+        // a parser that grew beyond the maximum capacity is not kept
+        JsonParserPool pool(64);
+        std::string json = R"({"value": ")" + std::string(100, 'a') + R"("})";
+        {
+            PooledJsonDocument document;
+            ASSERT_EQ(pool.parse(json, document), simdjson::SUCCESS);
+            ASSERT_EQ(document.document["value"].get_string().value().size(), 100);
+        }
+        ASSERT_EQ(pool.size(), 0);
+    }
+
+    TEST(ParseJson, ParserPoolThreads)
+    {
+        JsonParserPool pool;
+        std::vector<std::thread> threads;
+        std::vector<bool> succeeded(4, false);
+        for (size_t i = 0; i < succeeded.size(); i++)
+        {
+            threads.emplace_back([&, i]() {
+                bool success = true;
+                for (uint64_t j = 0; j < 100; j++)
+                {
+                    std::string json = R"({"thread": )" + std::to_string(i) + R"(, "value": )" + std::to_string(j) + "}";
+                    PooledJsonDocument document;
+                    success &= pool.parse(json, document) == simdjson::SUCCESS;
+                    success &= document.document["thread"].get_uint64().value() == i;
+                    success &= document.document["value"].get_uint64().value() == j;
+                }
+                succeeded[i] = success;
+            });
+        }
+        for (std::thread& thread: threads)
+        {
+            thread.join();
+        }
+        ASSERT_EQ(succeeded, std::vector<bool>(4, true));
+        ASSERT_LE(pool.size(), 4);
+    }
+}
@@ -3,8 +3,13 @@
 #include <xrit_unreal/reflect/reflect.h>
 #include <xrit_unreal/reflect/parse.h>
 #include <xrit_unreal/reflect/serialize.h>
+#include <xrit_unreal/data/livelink.h>
 #include <xrit_unreal/parse_json.h>
 
+#include <limits>
+#include <memory_resource>
+#include <random>
+
 namespace xrit_unreal::reflection_tests
 {
     // enum
@@ -42,10 +47,10 @@ namespace xrit_unreal::reflection_tests
 
     TEST(Reflection, EnumSerialize)
     {
-        std::stringstream out;
+        JsonWriter out;
         ReflectionEnumTest value = ReflectionEnumTest::Case5;
         serialize(value, out);
-        ASSERT_EQ(out.str(), "\"Case5\"");
+        ASSERT_EQ(out.view(), "\"Case5\"");
     }
 
     // vector
@@ -60,12 +65,43 @@ namespace xrit_unreal::reflection_tests
         ASSERT_EQ(values, expected);
     }
 
+    TEST(Reflection, VectorParseCapacity)
+    {
+        JsonDocument d;
+        ASSERT_EQ(parseJson(R"({"values": [1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12]})", d), simdjson::SUCCESS);
+
+        // the capacity of the vector is kept, so reserving up front avoids reallocating while parsing
+        std::vector<int64_t> values;
+        values.reserve(20);
+        int64_t const* data = values.data();
+        ASSERT_TRUE(parse(d.document["values"], values, "values").empty());
+        ASSERT_EQ(values.size(), 12);
+        ASSERT_EQ(values.data(), data);
+        ASSERT_EQ(values.back(), 12);
+    }
+
+    TEST(Reflection, PmrVectorParse)
+    {
+        JsonDocument d;
+        ASSERT_EQ(parseJson(R"({"values": [0, 1, 0, 2, -43, 5, 6, 87, 9, 10]})", d), simdjson::SUCCESS);
+
+        // all entries should be allocated in the arena, which fails when it runs out instead of using the heap
+        std::array<std::byte, 1024> buffer{};
+        std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+        std::pmr::vector<int64_t> values(&arena);
+        ASSERT_TRUE(parse(d.document["values"], values, "values").empty());
+        std::pmr::vector<int64_t> expected{0, 1, 0, 2, -43, 5, 6, 87, 9, 10};
+        ASSERT_EQ(values, expected);
+        auto const* data = reinterpret_cast<std::byte const*>(values.data());
+        ASSERT_TRUE(data >= buffer.data() && data < buffer.data() + buffer.size());
+    }
+
     TEST(Reflection, VectorSerialize)
     {
-        std::stringstream out;
+        JsonWriter out;
         std::vector<uint64_t> values{0, 1, 2, 3, 10, 12};
         serialize(values, out);
-        ASSERT_EQ(out.str(), "[0,1,2,3,10,12]");
+        ASSERT_EQ(out.view(), "[0,1,2,3,10,12]");
     }
 
     // unordered map
@@ -92,10 +128,30 @@ namespace xrit_unreal::reflection_tests
 
     TEST(Reflection, UnorderedMapSerialize)
     {
-        std::stringstream out;
-        std::vector<uint64_t> values{0, 1, 2, 3, 10, 12};
-        serialize(values, out);
-        ASSERT_EQ(out.str(), "[0,1,2,3,10,12]");
+        std::unordered_map<std::string_view, int64_t> empty;
+        ASSERT_EQ(serializeToString(empty), "{}");
+
+        // the order of the entries is not defined
+        std::unordered_map<std::string_view, int64_t> values{{"a", 1}, {"b", -3}};
+        std::string json = serializeToString(values);
+        ASSERT_TRUE(json == R"({"a":1,"b":-3})" || json == R"({"b":-3,"a":1})") << json;
+    }
+
+    TEST(Reflection, RangeSerialize)
+    {
+        // values are serialized through const references
+        std::vector<uint64_t> const values{1, 2, 3};
+        ASSERT_EQ(serializeToString(values), "[1,2,3]");
+        ASSERT_EQ(serializeToString(SerializedRange<std::vector<uint64_t>>{values}), "[1,2,3]");
+
+        // the elements of the range are projected, e.g. to the values of a map
+        std::unordered_map<std::string_view, std::vector<int64_t>> map{{"a", {-1, 1}}};
+        SerializedRange mapValues{map, &std::pair<std::string_view const, std::vector<int64_t>>::second};
+        ASSERT_EQ(serializeToString(mapValues), "[[-1,1]]");
+
+        std::vector<uint64_t> const empty;
+        ASSERT_EQ(serializeToString(SerializedRange{empty, [](uint64_t value) { return value * 2; }}), "[]");
+        ASSERT_EQ(serializeToString(SerializedRange{values, [](uint64_t value) { return value * 2; }}), "[2,4,6]");
     }
 
     struct One
@@ -169,32 +225,54 @@ namespace xrit_unreal::reflection_tests
         ASSERT_TRUE(std::holds_alternative<Three>(variants));
         ASSERT_EQ(std::get<Three>(variants).three, 2.5f);
 
-        std::vector<ParseError> invalidErrors = parse(d.document["invalid"], variants, "invalid");
+        ParseErrors invalidErrors = parse(d.document["invalid"], variants, "invalid");
         ASSERT_FALSE(invalidErrors.empty());
-        std::vector<ParseError> invalid2Errors = parse(d.document["invalid2"], variants, "invalid2");
+        ParseErrors invalid2Errors = parse(d.document["invalid2"], variants, "invalid2");
         ASSERT_FALSE(invalid2Errors.empty());
 
         ASSERT_TRUE(parse(d.document["empty"], variants, "empty").empty());
         ASSERT_TRUE(std::holds_alternative<std::monostate>(variants));
     }
 
+    TEST(Reflection, VariantTypeLookup)
+    {
+        using Variant = std::variant<std::monostate, One, Two, Three>;
+        static_assert(variantTypeLookup<Variant>.find("xrit_unreal::reflection_tests::One") == 0);
+        static_assert(variantTypeLookup<Variant>.find("xrit_unreal::reflection_tests::Two") == 1);
+        static_assert(variantTypeLookup<Variant>.find("xrit_unreal::reflection_tests::Three") == 2);
+        static_assert(variantTypeLookup<Variant>.find("xrit_unreal::reflection_tests::Four") == 3);
+        static_assert(variantTypeLookup<Variant>.find("One") == 3);
+
+        // names that only differ in the middle from a type name hash to the same slot, but are not that type
+        JsonDocument d;
+        ASSERT_EQ(parseJson(R"({
+    "$type": "xrit_unreal::reflection_xxxxx::Two",
+    "two": 1
+})", d), simdjson::SUCCESS);
+        Variant variants;
+        ParseErrors errors = parse(d.document.get_value().value(), variants, "");
+        ASSERT_EQ(errors.size(), 1);
+        ASSERT_EQ(errors[0].code, ParseErrorCode::VariantTypeInvalid);
+        ASSERT_TRUE(std::holds_alternative<std::monostate>(variants));
+    }
+
     TEST(Reflection, VariantSerialize)
     {
-        std::stringstream out;
+        JsonWriter out;
         std::variant<std::monostate, One, Two, Three> variants = std::monostate{};
 
         serialize(variants, out);
-        ASSERT_EQ(out.str(), "{}");
+        ASSERT_EQ(out.view(), "{}");
 
-        std::stringstream out2;
+        JsonWriter out2;
         variants = One{.one = true};
         serialize(variants, out2);
-        ASSERT_EQ(out2.str(), R"({"$type":"xrit_unreal::reflection_tests::One","one":true})");
+        ASSERT_EQ(out2.view(), R"({"$type":"xrit_unreal::reflection_tests::One","one":true})");
 
-        std::stringstream out3;
+        JsonWriter out3;
         variants = Two{.two = 1235};
         serialize(variants, out3);
-        ASSERT_EQ(out3.str(), R"({"$type":"xrit_unreal::reflection_tests::Two","two":1235})");
+        ASSERT_EQ(out3.view(), R"({"$type":"xrit_unreal::reflection_tests::Two","two":1235})");
     }
 
     struct FurtherNestedClass
@@ -229,6 +307,12 @@ namespace xrit_unreal::reflection_tests
             return value1 == other.value1 && value2 == other.value2;
         }
     };
+
+    struct ClassWithDefaults
+    {
+        int64_t number = 8000;
+        float value = 2.5f;
+    };
 }
 
 
@@ -247,6 +331,11 @@ REFLECT_IMPL_STRUCT_BEGIN(xrit_unreal::reflection_tests::Class)
                     REFLECT_IMPL_FIELD(value2)
 REFLECT_IMPL_STRUCT_END
 
+REFLECT_IMPL_STRUCT_BEGIN(xrit_unreal::reflection_tests::ClassWithDefaults)
+                    REFLECT_IMPL_FIELD(number)
+                    REFLECT_IMPL_FIELD(value)
+REFLECT_IMPL_STRUCT_END
+
 namespace xrit_unreal::reflection_tests
 {
     // class
@@ -295,13 +384,96 @@ namespace xrit_unreal::reflection_tests
             }
         };
         ASSERT_EQ(value, expected);
-        std::vector<ParseError> invalidClassErrors = parse(d.document["invalidClass"], value, "invalidClass");
+        ParseErrors invalidClassErrors = parse(d.document["invalidClass"], value, "invalidClass");
         ASSERT_FALSE(invalidClassErrors.empty());
     }
 
+    TEST(Reflection, ClassParseFieldOrder)
+    {
+        // fields in declaration order, out of order, and with an unknown field in between should all parse the same
+        for (std::string_view json: {
+            R"({"value1": {"a": {"some": true, "value": 1.5}, "b": true}, "value2": {"a": {"some": true, "value": 2.5}, "b": false}})",
+            R"({"value2": {"b": false, "a": {"value": 2.5, "some": true}}, "value1": {"b": true, "a": {"value": 1.5, "some": true}}})",
+            R"({"value1": {"b": true, "a": {"some": true, "value": 1.5}}, "value2": {"a": {"value": 2.5, "some": true}, "b": false}})"})
+        {
+            JsonDocument d;
+            ASSERT_EQ(parseJson(json, d), simdjson::SUCCESS);
+            Class value{};
+            ASSERT_TRUE(parse(d.document.get_value().value(), value, "").empty()) << json;
+            Class expected{
+                .value1{.a{.some = true, .value = 1.5f}, .b = true},
+                .value2{.a{.some = true, .value = 2.5f}, .b = false}
+            };
+            ASSERT_EQ(value, expected) << json;
+        }
+
+        // an unknown field does not change which field is expected next
+        JsonDocument d;
+        ASSERT_EQ(parseJson(R"({"some": true, "unknown": 1, "value": 3.5})", d), simdjson::SUCCESS);
+        FurtherNestedClass value{};
+        ParseErrors errors = parse(d.document.get_value().value(), value, "");
+        ASSERT_EQ(errors.size(), 1);
+        ASSERT_EQ(errors[0].code, ParseErrorCode::InvalidField);
+        ASSERT_EQ(errors[0].value, "unknown");
+        ASSERT_TRUE(value.some);
+        ASSERT_EQ(value.value, 3.5f);
+    }
+
+    TEST(Reflection, ParseInPlace)
+    {
+        JsonDocument d;
+        ASSERT_EQ(parseJson(R"({
+    "partial": {"value1": {"b": true}},
+    "invalid": {"value1": {"a": {"some": true, "value": "not a float"}}},
+    "list": [1, 2],
+    "two": {"$type": "xrit_unreal::reflection_tests::Two", "two": 5},
+    "defaults": {"value": 3.5},
+    "defaultsVariant": {"$type": "xrit_unreal::reflection_tests::ClassWithDefaults", "value": 3.5}
+})", d), simdjson::SUCCESS);
+
+        // fields that are not in the json are reset, so nothing from before the parse ends up in the result
+        Class value{.value1{.a{.some = false, .value = 1.5f}, .b = false}, .value2{.a{.some = true, .value = 2.5f}, .b = true}};
+        ASSERT_TRUE(parse(d.document["partial"], value, "partial").empty());
+        Class expected{.value1{.a{}, .b = true}, .value2{}};
+        ASSERT_EQ(value, expected);
+
+        // fields are reset to their default member initializers, as if parsed into T{}
+        ClassWithDefaults withDefaults{.number = 1, .value = 1.0f};
+        ASSERT_TRUE(parse(d.document["defaults"], withDefaults, "defaults").empty());
+        ASSERT_EQ(withDefaults.number, 8000);
+        ASSERT_EQ(withDefaults.value, 3.5f);
+
+        // on error, the values parsed before the error are kept, unless reset is requested
+        ParseErrors errors = parse(d.document["invalid"], value, "invalid");
+        ASSERT_EQ(errors.size(), 1);
+        ASSERT_TRUE(value.value1.a.some);
+        ParseErrors resetErrors = parse(d.document["invalid"], value, "invalid", {.resetOnError = true});
+        ASSERT_EQ(resetErrors.size(), 1);
+        ASSERT_EQ(value, Class{});
+
+        // vectors are replaced
+        std::vector<int64_t> list{7, 8, 9};
+        ASSERT_TRUE(parse(d.document["list"], list, "list").empty());
+        ASSERT_EQ(list, (std::vector<int64_t>{1, 2}));
+
+        // a variant that holds a different type gets the new type, and one that holds the type is parsed into
+        std::variant<std::monostate, One, Two, Three> variant = One{.one = true};
+        ASSERT_TRUE(parse(d.document["two"], variant, "two").empty());
+        ASSERT_EQ(std::get<Two>(variant).two, 5);
+        std::get<Two>(variant).two = 6;
+        ASSERT_TRUE(parse(d.document["two"], variant, "two").empty());
+        ASSERT_EQ(std::get<Two>(variant).two, 5);
+
+        // the fields of the alternative that are not in the json are reset to their defaults
+        std::variant<std::monostate, One, ClassWithDefaults> variantWithDefaults = ClassWithDefaults{.number = 1};
+        ASSERT_TRUE(parse(d.document["defaultsVariant"], variantWithDefaults, "defaultsVariant").empty());
+        ASSERT_EQ(std::get<ClassWithDefaults>(variantWithDefaults).number, 8000);
+        ASSERT_EQ(std::get<ClassWithDefaults>(variantWithDefaults).value, 3.5f);
+    }
+
     TEST(Reflection, ClassSerialize)
     {
-        std::stringstream out;
+        JsonWriter out;
         Class value{
             .value1{
                 .a{
@@ -319,41 +491,320 @@ namespace xrit_unreal::reflection_tests
             }
         };
         serialize(value, out);
-        ASSERT_EQ(out.str(), R"({"value1":{"a":{"some":false,"value":1234.5},"b":true},"value2":{"a":{"some":true,"value":0},"b":false}})");
+        ASSERT_EQ(out.view(), R"({"value1":{"a":{"some":false,"value":1234.5},"b":true},"value2":{"a":{"some":true,"value":0},"b":false}})");
+    }
+
+    TEST(Reflection, JsonWriter)
+    {
+        // appends to the buffer of the caller
+        std::string buffer = "header\n";
+        JsonWriter out(buffer);
+        std::vector<int64_t> values{std::numeric_limits<int64_t>::min(), -1, 0, std::numeric_limits<int64_t>::max()};
+        serialize(values, out);
+        ASSERT_EQ(buffer, "header\n[-9223372036854775808,-1,0,9223372036854775807]");
+
+        uint64_t large = std::numeric_limits<uint64_t>::max();
+        ASSERT_EQ(serializeToString(large), "18446744073709551615");
+
+        // floats are written with the shortest representation that parses back to the same float
+        for (float value: {0.1f, 1.0f / 3.0f, 1e-10f, 16777216.0f, -2.5f, std::numeric_limits<float>::max()})
+        {
+            std::string json = serializeToString(value);
+            ASSERT_EQ(std::stof(json), value) << json;
+        }
+        float tenth = 0.1f;
+        ASSERT_EQ(serializeToString(tenth), "0.1");
+
+        // empty containers have no separators
+        std::vector<std::vector<uint64_t>> nested{{}, {1}, {}};
+        ASSERT_EQ(serializeToString(nested), "[[],[1],[]]");
+        std::variant<std::monostate, One, Two, Three> variant = Three{.three = 0.5f};
+        ASSERT_EQ(serializeToString(variant), R"({"$type":"xrit_unreal::reflection_tests::Three","three":0.5})");
+    }
+
+    TEST(Reflection, StringEscape)
+    {
+        auto escaped = [](std::string_view value) {
+            return serializeToString(value);
+        };
+        ASSERT_EQ(escaped(""), R"("")");
+        ASSERT_EQ(escaped("plain text"), R"("plain text")");
+        ASSERT_EQ(escaped(R"(say "hi")"), R"("say \"hi\"")");
+        ASSERT_EQ(escaped(R"(C:\path)"), R"("C:\\path")");
+        ASSERT_EQ(escaped("\b\f\n\r\t"), R"("\b\f\n\r\t")");
+        ASSERT_EQ(escaped(std::string_view("\0\x01\x1f\x7f", 4)), "\"\\u0000\\u0001\\u001f\x7f\"");
+        ASSERT_EQ(escaped("caf\xc3\xa9 \xe2\x82\xac"), "\"caf\xc3\xa9 \xe2\x82\xac\""); // utf-8 is copied as is
+
+        // characters to escape at every position of a vectorized block, and after it
+        for (size_t i = 0; i < 40; i++)
+        {
+            std::string value(40, 'a');
+            value[i] = '"';
+            std::string expected = "\"" + value.substr(0, i) + "\\\"" + value.substr(i + 1) + "\"";
+            ASSERT_EQ(escaped(value), expected) << i;
+        }
+
+        // map keys are escaped as well
+        std::unordered_map<std::string_view, uint64_t> map{{"a\"b", 1}};
+        ASSERT_EQ(serializeToString(map), R"({"a\"b":1})");
+    }
+
+    TEST(Reflection, StringEscapeRoundTrip)
+    {
+        // random strings of valid utf-8, with many characters that need escaping, of lengths around the block sizes
+        std::mt19937 random(45);
+        std::vector<std::string_view> const pieces{
+            "a", "Z", " ", "\"", "\\", "/", "\n", "\t", "\b", "\x01", "\x1f", "\x7f", "\xc3\xa9", "\xe2\x82\xac",
+            "\xf0\x9f\x98\x80", std::string_view("\0", 1)};
+        std::uniform_int_distribution<size_t> piece(0, pieces.size() - 1);
+        std::uniform_int_distribution<size_t> length(0, 70);
+        std::bernoulli_distribution clean(0.9);
+
+        for (int iteration = 0; iteration < 200; iteration++)
+        {
+            std::vector<std::string> strings(8);
+            for (std::string& string: strings)
+            {
+                size_t count = length(random);
+                for (size_t i = 0; i < count; i++)
+                {
+                    // mostly clean text, so that runs cross the block boundaries
+                    string += clean(random) ? pieces[0] : pieces[piece(random)];
+                }
+            }
+            std::vector<std::string_view> values(strings.begin(), strings.end());
+            std::string json = serializeToString(values);
+
+            JsonDocument d;
+            ASSERT_EQ(parseJson(json, d), simdjson::SUCCESS) << json;
+            std::vector<std::string_view> parsed;
+            ASSERT_TRUE(parse(d.document.get_value().value(), parsed, "").empty()) << json;
+            ASSERT_EQ(parsed, values) << json;
+        }
+    }
+
+    // serializedSize gives the size of the output of serialize, for every kind of value
+    template<typename T>
+    void assertSerializedSize(T const& value)
+    {
+        std::string json = serializeToString(value);
+        ASSERT_EQ(serializedSize(value), json.size()) << json;
+    }
+
+    TEST(Reflection, SerializedSize)
+    {
+        for (int64_t value: {int64_t(0), int64_t(9), int64_t(10), int64_t(-1), int64_t(-10), int64_t(99),
+                             int64_t(1000), int64_t(9999), int64_t(10000), int64_t(-123456789),
+                             std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()})
+        {
+            assertSerializedSize(value);
+        }
+        // every amount of digits
+        for (uint64_t value = 10; value <= std::numeric_limits<uint64_t>::max() / 10; value *= 10)
+        {
+            assertSerializedSize(value);
+            assertSerializedSize(value - 1);
+        }
+        assertSerializedSize(std::numeric_limits<uint64_t>::max());
+        for (float value: {0.f, -0.f, 1.f, 0.1f, -1234.5f, 1e-20f, 3.4e38f, std::numeric_limits<float>::min(),
+                           std::numeric_limits<float>::denorm_min()})
+        {
+            assertSerializedSize(value);
+        }
+        assertSerializedSize(true);
+        assertSerializedSize(false);
+
+        // escaped characters
+        for (std::string_view value: {"", "text", "\"\\/\b\f\n\r\t", "\x01\x1f\x7f",
+                                      "\xc3\xa9 a longer string with a \" quote after the first block and a \x02 "
+                                      "control character"})
+        {
+            assertSerializedSize(value);
+        }
+        assertSerializedSize(std::string_view("\0", 1));
+
+        assertSerializedSize(ReflectionEnumTest::Case5);
+        assertSerializedSize(std::vector<int64_t>{});
+        assertSerializedSize(std::vector<int64_t>{1, -22, 333});
+        assertSerializedSize(std::unordered_map<std::string_view, int64_t>{});
+        assertSerializedSize(std::unordered_map<std::string_view, int64_t>{{"a", 1}, {"b\n", -3}});
+        assertSerializedSize(std::unordered_map<uint64_t, std::vector<bool>>{{0, {}}, {12345, {true, false}}});
+        std::vector<uint64_t> const values{1, 20, 300};
+        assertSerializedSize(SerializedRange{values, [](uint64_t value) { return value * 1000; }});
+
+        using Variant = std::variant<std::monostate, One, Two, Three>;
+        for (Variant const& value: {Variant{}, Variant{One{.one = true}}, Variant{Two{.two = -5}},
+                                    Variant{Three{.three = 0.25f}}})
+        {
+            assertSerializedSize(value);
+        }
+
+        assertSerializedSize(Class{.value1{.a{.some = false, .value = 1234.5f}, .b = true}, .value2{}});
+    }
+
+    TEST(Reflection, ParseErrors)
+    {
+        JsonDocument d;
+        ASSERT_EQ(parseJson(R"({
+    "a": {"unknown1": 1, "unknown2": 2, "unknown3": 3, "unknown4": 4, "unknown5": 5, "unknown6": 6},
+    "b": {"value1": {"a": {"some": 1, "value": "1"}, "b": 1}, "value2": {"a": {"some": 1, "value": "1"}, "b": 1}}
+})", d), simdjson::SUCCESS);
+
+        // more errors than fit inline
+        Class value{};
+        ParseErrors errors = parse(d.document["a"], value, "a");
+        ASSERT_EQ(errors.size(), 6);
+        ASSERT_GT(errors.size(), ParseErrors::inlineCapacity);
+        for (size_t i = 0; i < errors.size(); i++)
+        {
+            ASSERT_EQ(errors[i].code, ParseErrorCode::InvalidField);
+            ASSERT_EQ(errors[i].containing_object, "/a");
+            ASSERT_EQ(errors[i].value, "unknown" + std::to_string(i + 1));
+        }
+
+        // errors stay valid after moving (including owned messages)
+        ParseErrors errorsB = parse(d.document["b"], value, "b");
+        ASSERT_EQ(errorsB.size(), 6);
+        ParseErrors moved = std::move(errorsB);
+        ASSERT_EQ(moved[0].code, ParseErrorCode::InvalidValue);
+        ASSERT_EQ(moved[0].containing_object, "/b/value1/a/some");
+        ASSERT_EQ(moved[0].message, "Expected field to be of type bool");
+        ASSERT_EQ(moved[1].message, "Expected field to be of type double"); // floats are parsed as double
+
+        // parsing stops after the maximum amount of errors
+        ParseErrors capped = parse(d.document["b"], value, "b", {.maxErrorCount = 2});
+        ASSERT_EQ(capped.size(), 2);
+        ASSERT_TRUE(capped.full());
+        ASSERT_EQ(capped[1].message, "Expected field to be of type double");
+    }
+
+    TEST(Reflection, ParseErrorPaths)
+    {
+        JsonDocument d;
+        ASSERT_EQ(parseJson(R"({
+    "list": [{"some": true, "value": 1}, {"some": true, "value": 1, "unknown": 1}, {"some": 1, "value": 1}],
+    "map": {"a/b~c": {"some": true, "value": "1"}}
+})", d), simdjson::SUCCESS);
+
+        // array indices
+        std::vector<FurtherNestedClass> list;
+        ParseErrors listErrors = parse(d.document["list"], list, "list");
+        ASSERT_EQ(listErrors.size(), 2);
+        ASSERT_EQ(listErrors[0].code, ParseErrorCode::InvalidField);
+        ASSERT_EQ(listErrors[0].containing_object, "/list/1");
+        ASSERT_EQ(listErrors[0].value, "unknown");
+        ASSERT_EQ(listErrors[1].code, ParseErrorCode::InvalidValue);
+        ASSERT_EQ(listErrors[1].containing_object, "/list/2/some");
+
+        // escaped keys
+        std::unordered_map<std::string_view, FurtherNestedClass> map;
+        ParseErrors mapErrors = parse(d.document["map"], map, "map");
+        ASSERT_EQ(mapErrors.size(), 1);
+        ASSERT_EQ(mapErrors[0].containing_object, "/map/a~1b~0c/value");
+
+        // document root
+        JsonDocument rootDocument;
+        ASSERT_EQ(parseJson(R"({"some": 1})", rootDocument), simdjson::SUCCESS);
+        FurtherNestedClass root;
+        ParseErrors rootErrors = parse(rootDocument.document.get_value().value(), root, "");
+        ASSERT_EQ(rootErrors.size(), 1);
+        ASSERT_EQ(rootErrors[0].containing_object, "/some");
+    }
+
+    TEST(Reflection, ParseMany)
+    {
+        std::vector<FurtherNestedClass> values;
+        std::vector<ParseErrors> errors;
+        auto onDocument = [&](FurtherNestedClass& value, ParseErrors& documentErrors) {
+            values.push_back(value);
+            errors.push_back(std::move(documentErrors));
+        };
+
+        // newline delimited, the second document has an error, and the fields of the third are not taken from the
+        // previous documents
+        std::string ndjson = "{\"some\": true, \"value\": 1}\n{\"some\": 1, \"value\": 2}\n{\"value\": 3}\n";
+        ASSERT_EQ(parseMany<FurtherNestedClass>(padString(ndjson), onDocument), simdjson::SUCCESS);
+        ASSERT_EQ(values.size(), 3);
+        ASSERT_EQ(values[0], (FurtherNestedClass{.some = true, .value = 1}));
+        ASSERT_TRUE(errors[0].empty());
+        ASSERT_EQ(values[1].value, 2);
+        ASSERT_EQ(errors[1].size(), 1);
+        ASSERT_EQ(errors[1][0].containing_object, "/some");
+        ASSERT_EQ(values[2], (FurtherNestedClass{.some = false, .value = 3}));
+        ASSERT_TRUE(errors[2].empty());
+
+        // concatenated without separator
+        values.clear();
+        errors.clear();
+        std::string concatenated = R"({"some": true}{"value": 5})";
+        ASSERT_EQ(parseMany<FurtherNestedClass>(padString(concatenated), onDocument), simdjson::SUCCESS);
+        ASSERT_EQ(values.size(), 2);
+        ASSERT_EQ(values[0], (FurtherNestedClass{.some = true, .value = 0}));
+        ASSERT_EQ(values[1], (FurtherNestedClass{.some = false, .value = 5}));
+
+        // empty
+        values.clear();
+        std::string empty;
+        ASSERT_EQ(parseMany<FurtherNestedClass>(padString(empty), onDocument), simdjson::SUCCESS);
+        ASSERT_TRUE(values.empty());
+
+        // the documents before an incomplete document are still parsed
+        std::string truncated = R"({"value": 1} {"value": 2} {"value": )";
+        ASSERT_EQ(parseMany<FurtherNestedClass>(padString(truncated), onDocument),
+                  simdjson::INCOMPLETE_ARRAY_OR_OBJECT);
+        ASSERT_EQ(values.size(), 2);
+        ASSERT_EQ(values[1].value, 2);
     }
 
     TEST(Reflection, Name)
     {
-        std::string_view namespacePrefix = "xrit_unreal::reflection_tests::";
-
-        // class
-        std::string_view a = typeName<Class>();
-        std::ostringstream aExpected;
-        aExpected << "class " << namespacePrefix << "Class";
-        ASSERT_EQ(a, aExpected.str());
-
-        // variant
-        std::string_view b = typeName<std::variant<std::monostate, One, Two, Three>>();
-        std::ostringstream bExpected;
-        bExpected << "variant<" << namespacePrefix << "One, " << namespacePrefix << "Two, " << namespacePrefix << "Three>";
-        ASSERT_EQ(b, bExpected.str());
-
-        // enum
-        std::string_view c = typeName<ReflectionEnumTest>();
-        std::ostringstream cExpected;
-        cExpected << "enum " << namespacePrefix << "ReflectionEnumTest";
-        ASSERT_EQ(c, cExpected.str());
-
-        // dictionary
-        std::string_view d = typeName<std::unordered_map<uint64_t, Class>>();
-        std::ostringstream dExpected;
-        dExpected << "dictionary<uint64, " << aExpected.str() << ">";
-        ASSERT_EQ(d, dExpected.str());
-
-        // list
-        std::string_view e = typeName<std::vector<ReflectionEnumTest>>();
-        std::ostringstream eExpected;
-        eExpected << "list<" << cExpected.str() << ">";
-        ASSERT_EQ(e, eExpected.str());
+        // the names are built at compile time
+        static_assert(typeName<Class>() == "class xrit_unreal::reflection_tests::Class");
+        static_assert(typeName<std::variant<std::monostate, One, Two, Three>>() ==
+                      "variant<xrit_unreal::reflection_tests::One, xrit_unreal::reflection_tests::Two, "
+                      "xrit_unreal::reflection_tests::Three>");
+        static_assert(typeName<std::variant<std::monostate, One>>() == "variant<xrit_unreal::reflection_tests::One>");
+        static_assert(typeName<ReflectionEnumTest>() == "enum xrit_unreal::reflection_tests::ReflectionEnumTest");
+        static_assert(typeName<std::unordered_map<uint64_t, Class>>() ==
+                      "dictionary<uint64, class xrit_unreal::reflection_tests::Class>");
+        static_assert(typeName<std::vector<ReflectionEnumTest>>() ==
+                      "list<enum xrit_unreal::reflection_tests::ReflectionEnumTest>");
+        static_assert(typeName<std::vector<std::unordered_map<std::string_view, double>>>() ==
+                      "list<dictionary<string, double>>");
     }
-}
\ No newline at end of file
+
+    TEST(Reflection, Equality)
+    {
+        static_assert(Reflected<LiveLinkFreeDSource>);
+        static_assert(!Reflected<Guid>);
+        static_assert(!Reflected<std::string_view>);
+
+        LiveLinkFreeDSource a{.id{1, 2, 3, 4}, .subjects{1, 2}};
+        LiveLinkFreeDSource b = a;
+        ASSERT_TRUE(a == b);
+
+        // nested fields, including mutable ones
+        b.settings.base.buffer_settings.source_timecode_framerate.denominator = 2;
+        ASSERT_FALSE(a == b);
+        ASSERT_TRUE(a != b);
+        b = a;
+        b.settings.focal_length_encoder_data.max = 1;
+        ASSERT_NE(a, b);
+        b = a;
+        b.subjects.push_back(3);
+        ASSERT_NE(a, b);
+
+        // string views are compared by their characters
+        std::string address = "127.0.0.1";
+        b = a;
+        b.settings.ip_address = address;
+        ASSERT_EQ(a, b);
+
+        // variants compare the alternative and its fields
+        LiveLinkSourceVariants variantA = a;
+        LiveLinkSourceVariants variantB = a;
+        ASSERT_EQ(variantA, variantB);
+        variantB = LiveLinkMvnSource{.id = a.id};
+        ASSERT_NE(variantA, variantB);
+    }
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include <xrit_unreal/data/configuration.h>
+#include <xrit_unreal/generate_mock_data.h>
+#include <xrit_unreal/parse_json.h>
+#include <xrit_unreal/reflect/parse.h>
+#include <xrit_unreal/reflect/serialize.h>
+#include <xrit_unreal/string_arena.h>
+
+#include <algorithm>
+#include <optional>
+
+namespace xrit_unreal::string_arena_tests
+{
+    TEST(StringArena, Store)
+    {
+        StringArena arena(8);
+        std::string string = "abcde";
+        std::string_view stored = arena.store(string);
+        string = "xxxxx";
+        ASSERT_EQ(stored, "abcde");
+        ASSERT_EQ(arena.store(""), "");
+
+        // doesn't fit in the remaining 3 characters of the block
+        std::string_view overflow = arena.store("fghij");
+        ASSERT_EQ(overflow, "fghij");
+        std::string_view fits = arena.store("klm");
+        ASSERT_EQ(fits, "klm");
+        ASSERT_EQ(fits.data(), stored.data() + stored.size());
+        ASSERT_EQ(arena.size(), 13);
+
+        // moving keeps the strings at the same address
+        StringArena moved = std::move(arena);
+        ASSERT_EQ(stored, "abcde");
+        ASSERT_EQ(overflow, "fghij");
+    }
+
+    TEST(StringArena, ParseOutlivesJson)
+    {
+        std::string json = generateMockConfiguration();
+        StringArena arena(json.size());
+        Configuration configuration{};
+        std::string expected;
+        {
+            JsonDocument document;
+            ASSERT_EQ(parseJson(json, document), simdjson::SUCCESS);
+            ASSERT_TRUE(parse(document.document.get_value().value(), configuration, "", {.arena = &arena}).empty());
+
+            expected = serializeToString(configuration);
+        }
+        // overwrite the json, so that strings that still reference it would change
+        std::fill(json.begin(), json.end(), 'x');
+
+        ASSERT_EQ(serializeToString(configuration), expected);
+        ASSERT_GT(arena.size(), 0);
+        ASSERT_LE(arena.size(), arena.capacity());
+    }
+
+    TEST(StringArena, ParseErrorsOutliveJson)
+    {
+        std::string json = R"({"some": "not a bool"})";
+        StringArena arena(json.size());
+        std::optional<ParseErrors> errors;
+        {
+            JsonDocument document;
+            ASSERT_EQ(parseJson(json, document), simdjson::SUCCESS);
+            bool value;
+            errors = parse(document.document["some"], value, "some", {.arena = &arena});
+        }
+        std::fill(json.begin(), json.end(), 'x');
+
+        ASSERT_EQ(errors->size(), 1);
+        ASSERT_EQ((*errors)[0].containing_object, "/some");
+        ASSERT_EQ((*errors)[0].value, R"("not a bool")");
+    }
+}
@@ -170,8 +170,6 @@ void XritCommunication::UpdateLiveLinkSourceCacheEntry(FXritContext& Context, xr
 }
 
 void XritCommunication::SendStatus(FXritContext& Context, xrit_unreal::WebSocket& Caller) {
-	xrit_unreal::Configuration Status{};
-
 	// cache entries to clear after iteration
 	std::vector<xrit_unreal::Guid> CacheEntriesToErase;
 
@@ -186,9 +184,6 @@ void XritCommunication::SendStatus(FXritContext& Context, xrit_unreal::WebSocket
 
 		// update the settings of the source
 		UpdateLiveLinkSourceCacheEntry(Context, Entry.first, Entry.second);
-
-		// populate the Status object with this source object (using copy)
-		Status.livelink.sources.emplace_back(Entry.second.value);
 	}
 
 	// clear invalid cache entries
@@ -197,34 +192,19 @@ void XritCommunication::SendStatus(FXritContext& Context, xrit_unreal::WebSocket
 		Context.LiveLinkSourceCache.entries.erase(Entry);
 	}
 
-	// serialize the status object and send to XR-IT Node
-	std::stringstream Out;
-	xrit_unreal::serialize(Status, Out);
-	Caller.sendMessage(xrit_unreal::createNodeMessage(xrit_unreal::NodeCommand::status, Out.str()));
+	// the status references the sources in the cache, instead of copying them
+	xrit_unreal::StatusView Status{.livelink{.sources{Context.LiveLinkSourceCache.entries}}};
+
+	// serialize the status object directly into the message and send to XR-IT Node
+	xrit_unreal::NodeMessageBuilder Builder(xrit_unreal::NodeCommand::status);
+	xrit_unreal::serialize(Status, Builder.payload());
+	Caller.sendMessage(std::move(Builder).finish());
 }
 
 xrit_unreal::SetConfigurationResult XritCommunication::
-SetConfiguration(FXritContext& Context, std::string const& Data) {
+SetConfiguration(FXritContext& Context, xrit_unreal::Configuration const& Configuration,
+	std::shared_ptr<xrit_unreal::StringArena const> const& Strings) {
 	xrit_unreal::SetConfigurationResult Result;
-	UE_LOGFMT(XritModule, Display, "Set Configuration {0}", Data.c_str());
-
-	// use simdjson for parsing the provided json
-	simdjson::padded_string const PaddedJson = simdjson::padded_string{ Data };
-	simdjson::ondemand::parser Parser;
-	simdjson::ondemand::document JsonDocument;
-	if (simdjson::error_code SimdjsonError = Parser.iterate(PaddedJson).get(JsonDocument); SimdjsonError != simdjson::SUCCESS)
-	{
-		Result.parse_errors.emplace_back(xrit_unreal::ParseError{ xrit_unreal::convert(SimdjsonError), {}, {}, simdjson::error_message(SimdjsonError) });
-		return Result;
-	}
-
-	// parse configuration data (from json to the C++ struct `Configuration`)
-	xrit_unreal::Configuration Configuration{};
-	std::vector<xrit_unreal::ParseError> ParseErrors = xrit_unreal::parse(JsonDocument.get_value().value(), Configuration, "root");
-	if (!ParseErrors.empty())
-	{
-		return Result;
-	}
 
 	// set udp unicast endpoint
 	ConfigurationSetUdpUnicastEndpoint(Context, Configuration.udp_unicast_endpoint);
@@ -244,31 +224,58 @@ SetConfiguration(FXritContext& Context, std::string const& Data) {
 			return UpdateLiveLinkSource(Context, Source, UnrealGuid);
 		}
 	};
-	Result.livelink_errors = xrit_unreal::setLiveLinkSources(Context.LiveLinkSourceCache, Configuration.livelink.sources, Callbacks);
+	// the cache entries keep the strings alive, because they reference the strings in the configuration
+	xrit_unreal::LiveLinkSourceChanges Changes;
+	Result.livelink_errors = xrit_unreal::setLiveLinkSources(Context.LiveLinkSourceCache, Configuration.livelink.sources, Callbacks, Strings, &Changes);
+	UE_LOGFMT(XritModule, Display, "LiveLink sources: {0} created, {1} updated, {2} unchanged, {3} removed",
+		Changes.created, Changes.updated, Changes.unchanged, Changes.removed);
 	return Result;
 }
 
 void XritCommunication::SetConfigurationAsync(FXritContext& Context, xrit_unreal::WebSocket& Caller,
-	std::string_view Data) {
-	TPromise<xrit_unreal::SetConfigurationResult> Promise;
-	TFuture<xrit_unreal::SetConfigurationResult> Future = Promise.GetFuture();
-
-	// we run setting the configuration on the game thread
-	// in addition, we copy the data to the lambda. Otherwise, the thread that has the Websocket connection will
-	// destroy the string object the string view references before it gets used. 
-	AsyncTask(ENamedThreads::GameThread, [&Context, Data = std::string(Data), &Promise]()
+	simdjson::padded_string_view Data) {
+	UE_LOGFMT(XritModule, Display, "Set Configuration {0}", XritConvert::ToFString(Data));
+
+	// parse configuration data (from json to the C++ struct `Configuration`) on this thread, directly from the padded
+	// receive buffer. The strings are copied into one arena, so that the configuration does not reference Data, which
+	// gets destroyed after this call, and can be used on the game thread and stored in the livelink source cache.
+	xrit_unreal::SetConfigurationResult Result;
+	xrit_unreal::PooledJsonDocument JsonDocument;
+	std::shared_ptr<xrit_unreal::StringArena> const Strings = std::make_shared<xrit_unreal::StringArena>(Data.size());
+	xrit_unreal::Configuration Configuration{};
+	std::optional<xrit_unreal::ParseErrors> ParseErrors;
+	if (simdjson::error_code SimdjsonError = xrit_unreal::jsonParserPool().parse(Data, JsonDocument); SimdjsonError != simdjson::SUCCESS)
+	{
+		Result.parse_errors.emplace_back(xrit_unreal::ParseError{ xrit_unreal::convert(SimdjsonError), {}, {}, simdjson::error_message(SimdjsonError) });
+	}
+	else
+	{
+		ParseErrors = xrit_unreal::parse(JsonDocument.document.get_value().value(), Configuration, "", { .arena = Strings.get() });
+		Result.parse_errors = ParseErrors->toVector();
+	}
+	// the configuration and the errors only reference the arena, so the parser can go back to the pool already
+	JsonDocument = xrit_unreal::PooledJsonDocument();
+
+	if (Result.parse_errors.empty())
 	{
-		xrit_unreal::SetConfigurationResult const Result = SetConfiguration(Context, Data);
-		Promise.SetValue(Result);
-	});
-
-	Future.Wait();
-	check(Future.IsReady());
-
-	// send the set_configuration_result message back
-	xrit_unreal::SetConfigurationResult Result = Future.Get();
-	std::stringstream Out;
-	xrit_unreal::serialize(Result, Out);
-	Caller.sendMessage(xrit_unreal::createNodeMessage(xrit_unreal::NodeCommand::set_configuration_result, Out.str()));
+		TPromise<xrit_unreal::SetConfigurationResult> Promise;
+		TFuture<xrit_unreal::SetConfigurationResult> Future = Promise.GetFuture();
+
+		// we run setting the configuration on the game thread
+		AsyncTask(ENamedThreads::GameThread, [&Context, &Configuration, &Strings, &Promise]()
+		{
+			Promise.SetValue(SetConfiguration(Context, Configuration, Strings));
+		});
+
+		Future.Wait();
+		check(Future.IsReady());
+		Result = Future.Get();
+	}
+
+	// send the set_configuration_result message back, the payload is allocated once with its exact size
+	xrit_unreal::NodeMessageBuilder Builder(xrit_unreal::NodeCommand::set_configuration_result,
+		xrit_unreal::serializedSize(Result));
+	xrit_unreal::serialize(Result, Builder.payload());
+	Caller.sendMessage(std::move(Builder).finish());
 	SendStatus(Context, Caller);
 }
@@ -12,11 +12,17 @@ THIRD_PARTY_INCLUDES_START // required to make sure unreal doesn't treat warning
 XRIT_DISABLE_WARNINGS // additional errors
 #include <xrit_unreal/communication_protocol.h>
 #include <xrit_unreal/data/configuration.h>
+#include <xrit_unreal/parse_json.h>
 #include <xrit_unreal/reflect/parse.h>
 #include <xrit_unreal/reflect/serialize.h>
 #include <xrit_unreal/websocket.h>
 #include <xrit_unreal/livelink.h>
+#include <xrit_unreal/status.h>
+#include <xrit_unreal/string_arena.h>
 THIRD_PARTY_INCLUDES_END
+
+#include <memory>
+#include <optional>
 XRIT_ENABLE_WARNINGS
 
 
@@ -108,10 +114,12 @@ private:
 	// sends the current status to the XR-IT Node
 	static void SendStatus(FXritContext& Context, xrit_unreal::WebSocket& Caller);
 
-	static xrit_unreal::SetConfigurationResult SetConfiguration(FXritContext& Context, std::string const& Data);
+	// applies the parsed configuration, Strings owns the strings the configuration references
+	static xrit_unreal::SetConfigurationResult SetConfiguration(FXritContext& Context, xrit_unreal::Configuration const& Configuration,
+		std::shared_ptr<xrit_unreal::StringArena const> const& Strings);
 
-	// sets the configuration asynchronously (on a separate thread), and after this sends a message back to the XR-IT Node with the result 
-	static void SetConfigurationAsync(FXritContext& Context, xrit_unreal::WebSocket& Caller, std::string_view Data);
+	// parses the configuration, sets it on the game thread, and after this sends a message back to the XR-IT Node with the result
+	static void SetConfigurationAsync(FXritContext& Context, xrit_unreal::WebSocket& Caller, simdjson::padded_string_view Data);
 
 public:
 	explicit XritCommunication(FXritContext& Context, xrit_unreal::WebSocketConfiguration const& Config) : Context(Context), WebSocket(Config)
@@ -172,13 +180,16 @@ public:
 	{
 		UE_LOGFMT(XritModule, Display, "Unreal service connected to XRIT Node");
 
-		// send initialized to node
-		Caller->sendMessage(xrit_unreal::createNodeMessage(xrit_unreal::NodeCommand::initialized, {}));
+		// use the plain text protocol until the node replies with its capabilities (older nodes never reply)
+		NegotiatedCapabilities = {};
+
+		// send initialized to node, containing the optional features we support
+		Caller->sendMessage(xrit_unreal::createNodeMessage(xrit_unreal::NodeCommand::initialized, xrit_unreal::serializeCapabilities(xrit_unreal::supportedCapabilities())));
 	}
 
-	virtual void onMessage(xrit_unreal::WebSocket* Caller, std::string Message) override
+	virtual void onMessage(xrit_unreal::WebSocket* Caller, simdjson::padded_string_view Message) override
 	{
-		UE_LOGFMT(XritModule, Display, "OnMessage: {0}", Message.c_str());
+		UE_LOGFMT(XritModule, Display, "OnMessage: {0}", XritConvert::ToFString(Message));
 		xrit_unreal::MessageData MessageData;
 		xrit_unreal::UnrealMessageData UnrealMessageData;
 		if (xrit_unreal::getMessageData(Message, &MessageData) && xrit_unreal::getUnrealMessage(MessageData, UnrealMessageData))
@@ -196,20 +207,40 @@ public:
 				SendStatus(Context, *Caller);
 				break;
 			}
+			case xrit_unreal::UnrealCommand::capabilities:
+			{
+				SetNodeCapabilities(UnrealMessageData.data);
+				break;
+			}
 			default:
 			{
-				UE_LOGFMT(XritModule, Warning, "Invalid command received in message from Node: {0}", Message.c_str());
+				UE_LOGFMT(XritModule, Warning, "Invalid command received in message from Node: {0}", XritConvert::ToFString(Message));
 			}
 			}
 		}
 		else
 		{
-			UE_LOGFMT(XritModule, Warning, "Received ill-formed message from Node: {0}", Message.c_str());
+			UE_LOGFMT(XritModule, Warning, "Received ill-formed message from Node: {0}", XritConvert::ToFString(Message));
 		}
 	}
 
 private:
+	// negotiates the features to use based on the capabilities sent by the node in reply to `initialized`
+	void SetNodeCapabilities(simdjson::padded_string_view Data)
+	{
+		xrit_unreal::Capabilities NodeCapabilities;
+		if (!xrit_unreal::parseCapabilities(Data, NodeCapabilities))
+		{
+			UE_LOGFMT(XritModule, Warning, "Received invalid capabilities from Node, using plain text protocol");
+			NegotiatedCapabilities = {};
+			return;
+		}
+		NegotiatedCapabilities = xrit_unreal::negotiateCapabilities(xrit_unreal::supportedCapabilities(), NodeCapabilities);
+		UE_LOGFMT(XritModule, Display, "Negotiated capabilities with Node: {0}", xrit_unreal::serializeCapabilities(NegotiatedCapabilities).c_str());
+	}
+
 	FXritContext& Context;
+	xrit_unreal::Capabilities NegotiatedCapabilities{};
 	std::atomic<bool> bStopping = false;
 	FRunnableThread* Thread = nullptr;
 	xrit_unreal::WebSocket WebSocket;